@@ -0,0 +1,189 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+
+namespace Bench {
+
+using json = nlohmann::json;
+
+// ── Options ───────────────────────────────────────────────────────────────
+struct Options {
+    std::string filter;             // substring match on benchmark name
+    uint32_t    seed        = 12345;
+    int         warmup      = 3;    // untimed ops before calibration
+    int         reps        = 15;   // timed samples per benchmark
+    double      minSampleMs = 20.0; // each sample repeats the op until this long
+    bool        quick       = false;// smaller problem sizes
+    bool        print       = true; // human-readable line per result on stdout
+    int         threads     = 0;    // scaling: highest thread count (0 = all)
+};
+
+using Params = std::vector<std::pair<std::string, double>>;
+
+// ── Result ────────────────────────────────────────────────────────────────
+struct Result {
+    std::string name;
+    Params      params;
+    double      itemsPerOp = 1.0;   // particles, queries, samples... per op
+    int         opsPerSample = 1;
+
+    Params      metrics;            // derived values (speedup...), not part of key()
+
+    std::vector<double> samplesNs;  // ns per op, one per sample
+    double medianNs = 0, meanNs = 0, stddevNs = 0, minNs = 0, maxNs = 0;
+
+    double throughput() const { return medianNs > 0 ? itemsPerOp * 1e9 / medianNs : 0.0; }
+    double cv()         const { return meanNs   > 0 ? stddevNs / meanNs : 0.0; }
+
+    // "Cluster::rule n=10000 radius=80" — stable key for baselines
+    std::string key() const {
+        std::string k = name;
+        char buf[64];
+        for (const auto& [pn, pv] : params) {
+            std::snprintf(buf, sizeof(buf), " %s=%g", pn.c_str(), pv);
+            k += buf;
+        }
+        return k;
+    }
+
+    void finalize() {
+        std::vector<double> s = samplesNs;
+        std::sort(s.begin(), s.end());
+        const size_t n = s.size();
+        if (n == 0) return;
+        medianNs = (n % 2) ? s[n / 2] : 0.5 * (s[n / 2 - 1] + s[n / 2]);
+        minNs = s.front();
+        maxNs = s.back();
+        double sum = 0.0;
+        for (double v : s) sum += v;
+        meanNs = sum / n;
+        double var = 0.0;
+        for (double v : s) var += (v - meanNs) * (v - meanNs);
+        stddevNs = n > 1 ? std::sqrt(var / (n - 1)) : 0.0;
+    }
+
+    json toJson() const {
+        json p = json::object();
+        for (const auto& [pn, pv] : params) p[pn] = pv;
+        json m = json::object();
+        for (const auto& [mn, mv] : metrics) m[mn] = mv;
+        return {
+            { "name",          name         },
+            { "key",           key()        },
+            { "params",        p            },
+            { "reps",          (int)samplesNs.size() },
+            { "ops_per_sample", opsPerSample },
+            { "ns_per_op",     medianNs     },
+            { "mean_ns",       meanNs       },
+            { "stddev_ns",     stddevNs     },
+            { "min_ns",        minNs        },
+            { "max_ns",        maxNs        },
+            { "cv",            cv()         },
+            { "items_per_op",  itemsPerOp   },
+            { "items_per_s",   throughput() },
+            { "metrics",       m            }
+        };
+    }
+};
+
+// Keeps the optimiser from discarding benchmark results
+inline volatile double g_sink = 0.0;
+inline void doNotOptimize(double v) { g_sink = g_sink + v; }
+
+inline void printHeader() {
+    std::printf("%-60s %14s %10s %8s %14s\n", "benchmark", "ns/op", "stddev", "cv", "items/s");
+}
+
+inline void printResult(const Result& r) {
+    std::printf("%-60s %14.1f %10.1f %7.2f%% %14.4g\n",
+                r.key().c_str(), r.medianNs, r.stddevNs, 100.0 * r.cv(), r.throughput());
+    std::fflush(stdout);
+}
+
+inline bool selected(const Options& opt, const std::string& name) {
+    return opt.filter.empty() || name.find(opt.filter) != std::string::npos;
+}
+
+// Runs `op` warmup times, calibrates how many ops make one sample last at
+// least minSampleMs, then records `reps` samples (ns per op).
+template<typename Op>
+Result measure(const std::string& name, const Params& params, double itemsPerOp,
+               const Options& opt, Op&& op)
+{
+    using Clock = std::chrono::steady_clock;
+    auto elapsedNs = [](Clock::time_point a, Clock::time_point b) {
+        return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(b - a).count();
+    };
+
+    for (int i = 0; i < opt.warmup; ++i) op();
+
+    int inner = 1;
+    for (;;) {
+        const auto t0 = Clock::now();
+        for (int i = 0; i < inner; ++i) op();
+        const double ms = elapsedNs(t0, Clock::now()) * 1e-6;
+        if (ms >= opt.minSampleMs || inner >= (1 << 20)) break;
+        inner = ms <= 0.0 ? inner * 16
+                          : std::max(inner + 1, (int)std::ceil(inner * opt.minSampleMs / ms));
+    }
+
+    Result r;
+    r.name         = name;
+    r.params       = params;
+    r.itemsPerOp   = itemsPerOp;
+    r.opsPerSample = inner;
+    for (int s = 0; s < opt.reps; ++s) {
+        const auto t0 = Clock::now();
+        for (int i = 0; i < inner; ++i) op();
+        r.samplesNs.push_back(elapsedNs(t0, Clock::now()) / inner);
+    }
+    r.finalize();
+    if (opt.print) printResult(r);
+    return r;
+}
+
+// ── Validation ────────────────────────────────────────────────────────────
+struct ValidationConfig {
+    int    perCluster    = 500;    // particles in each of the four clusters
+    int    steps         = 100;
+    double forceTol      = 1e-3;   // max |F_kernel - F_reference| per particle
+    double divergenceTol = -1.0;   // max position divergence after `steps` (< 0: report only)
+};
+
+// ── Suites (one translation unit each) ────────────────────────────────────
+// Kernel microbenchmarks: grid build/query, rules, boids, KNN, audio, MLP.
+void runKernels(const Options& opt, std::vector<Result>& out);
+// ParticleLife step across thread counts: strong (fixed n) and weak
+// (fixed n per thread) scaling at constant density, with speedup/efficiency.
+void runScaling(const Options& opt, std::vector<Result>& out);
+// Perf gate: the fixed, seeded quick kernel set, compared with a baseline.
+void runGate(const Options& opt, std::vector<Result>& out);
+
+// Matches results to baseline entries by key() and prints the comparison.
+// Compares the fastest sample (min_ns), which shrugs off interference from
+// other processes far better than the median. An entry regresses when it is
+// slower than the baseline by more than its "tolerance" (per entry, else
+// `tolerance`). Returns the regression count.
+int compareToBaseline(const std::vector<Result>& results, const json& baseline,
+                      double tolerance, bool print);
+
+// Re-runs every benchmark with a result beyond tolerance once more and keeps
+// the faster of the two, so a single noisy run does not fail the gate.
+void confirmRegressions(const Options& opt, std::vector<Result>& results,
+                        const json& baseline, double tolerance);
+
+// Golden reference: steps a seeded world (wrapping and clamping) through
+// Cluster::rule() and through a brute-force scalar oracle, checking the
+// kernel's forces every step and reporting the trajectories' divergence.
+// Fills `report` and returns the number of failed scenarios.
+int runValidation(const Options& opt, const ValidationConfig& cfg, json& report);
+
+} // namespace Bench
@@ -0,0 +1,100 @@
+#include "Bench.h"
+
+#include <map>
+#include <set>
+
+namespace Bench {
+
+namespace {
+
+struct Entry { double ns; double tolerance; };
+
+std::map<std::string, Entry> loadEntries(const json& baseline, double tolerance) {
+    std::map<std::string, Entry> base;
+    for (const auto& r : baseline.value("results", json::array())) {
+        if (!r.contains("key") || !r.contains("min_ns")) continue;
+        base[r["key"].get<std::string>()] = { r["min_ns"].get<double>(),
+                                              r.value("tolerance", tolerance) };
+    }
+    return base;
+}
+
+bool regressed(const Result& r, const std::map<std::string, Entry>& base) {
+    const auto it = base.find(r.key());
+    return it != base.end() && it->second.ns > 0.0
+        && r.minNs / it->second.ns - 1.0 > it->second.tolerance;
+}
+
+} // namespace
+
+void runGate(const Options& opt, std::vector<Result>& out) {
+    // Quick sizes keep the gate short; the set itself is fixed so keys stay
+    // comparable with the stored baseline.
+    Options gate = opt;
+    gate.quick  = true;
+    gate.filter.clear();
+    runKernels(gate, out);
+}
+
+void confirmRegressions(const Options& opt, std::vector<Result>& results,
+                        const json& baseline, double tolerance)
+{
+    const auto base = loadEntries(baseline, tolerance);
+    std::set<std::string> names;
+    for (const Result& r : results)
+        if (regressed(r, base)) names.insert(r.name);
+
+    for (const std::string& name : names) {
+        if (opt.print) std::printf("re-running %s to confirm\n", name.c_str());
+        Options again = opt;
+        again.quick  = true;
+        again.filter = name;
+        again.print  = false;
+        std::vector<Result> rerun;
+        runKernels(again, rerun);
+
+        for (Result& fresh : rerun)
+            for (Result& r : results)
+                if (r.key() == fresh.key() && fresh.minNs < r.minNs) r = std::move(fresh);
+    }
+}
+
+int compareToBaseline(const std::vector<Result>& results, const json& baseline,
+                      double tolerance, bool print)
+{
+    auto base = loadEntries(baseline, tolerance);
+
+    if (print)
+        std::printf("\n%-60s %14s %14s %9s  %s\n",
+                    "benchmark", "baseline min", "current min", "change", "status");
+
+    int regressions = 0;
+    for (const Result& r : results) {
+        const std::string key = r.key();
+        const auto it = base.find(key);
+        if (it == base.end()) {
+            if (print) std::printf("%-60s %14s %14.1f %9s  new\n", key.c_str(), "-", r.minNs, "-");
+            continue;
+        }
+
+        const Entry& e      = it->second;
+        const double change = e.ns > 0.0 ? r.minNs / e.ns - 1.0 : 0.0;
+        const bool   slower = regressed(r, base);
+        const bool   faster = change < -e.tolerance;
+        if (slower) ++regressions;
+
+        if (print)
+            std::printf("%-60s %14.1f %14.1f %+8.1f%%  %s\n", key.c_str(), e.ns, r.minNs,
+                        100.0 * change, slower ? "REGRESSION" : faster ? "faster" : "ok");
+        base.erase(it);
+    }
+
+    if (print) {
+        for (const auto& [key, e] : base)
+            std::printf("%-60s %14.1f %14s %9s  missing\n", key.c_str(), e.ns, "-", "-");
+        std::printf("\n%d regression(s) beyond tolerance\n", regressions);
+    }
+    return regressions;
+}
+
+} // namespace Bench
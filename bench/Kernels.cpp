@@ -0,0 +1,271 @@
+#include "Bench.h"
+
+#include "Core/Random.h"
+#include "Core/SpatialGrid.h"
+#include "Core/FrameArena.h"
+#include "Core/ParticleSplatter.h"
+#include "Core/DensityMap.h"
+#include "ParticleLife/Cluster.h"
+#include "Boids/BoidRenderer.h"
+#include "ParticleKNN/ParticleKNNSystem.h"
+#include "AudioCPPN/AudioBands.h"
+#include "AudioCPPN/SimpleMLP.h"
+
+#include <random>
+#include <cmath>
+
+namespace Bench {
+
+namespace {
+
+void uniformPoints(int n, float w, float h, std::vector<float>& x, std::vector<float>& y) {
+    std::uniform_real_distribution<float> dX(0.f, w), dY(0.f, h);
+    auto& gen = Random::Engine();
+    x.resize(n);
+    y.resize(n);
+    for (int i = 0; i < n; ++i) { x[i] = dX(gen); y[i] = dY(gen); }
+}
+
+// ── SpatialGrid ───────────────────────────────────────────────────────────
+void benchGrid(const Options& opt, std::vector<Result>& out) {
+    const float cs    = 80.f;
+    const float world = 4000.f;
+    const int   cells = (int)(world / cs) + 2;
+    const std::vector<int> sizes = opt.quick ? std::vector<int>{ 10000, 100000 }
+                                             : std::vector<int>{ 10000, 100000, 1000000 };
+
+    for (int n : sizes) {
+        Random::Seed(opt.seed);
+        std::vector<float> x, y;
+        uniformPoints(n, world, world, x, y);
+        SpatialGrid grid;
+
+        if (selected(opt, "SpatialGrid::build"))
+            out.push_back(measure("SpatialGrid::build", { { "n", n } }, n, opt, [&] {
+                grid.build(x.data(), y.data(), n, cs, cells, cells);
+                doNotOptimize(grid.start[cells]);
+            }));
+
+        grid.build(x.data(), y.data(), n, cs, cells, cells);
+        const int wcells = (int)(world / cs);
+        SpatialGrid wrapped;
+        wrapped.build(x.data(), y.data(), n, cs, wcells, wcells);
+
+        if (selected(opt, "SpatialGrid::forEachNeighbor"))
+            out.push_back(measure("SpatialGrid::forEachNeighbor", { { "n", n } }, n, opt, [&] {
+                long long visits = 0;
+                for (int i = 0; i < n; ++i)
+                    grid.forEachNeighbor((int)(x[i] / cs), (int)(y[i] / cs), cells, cells,
+                                         [&](int j) { visits += j; });
+                doNotOptimize((double)visits);
+            }));
+
+        if (selected(opt, "SpatialGrid::forEachNeighborWrapped"))
+            out.push_back(measure("SpatialGrid::forEachNeighborWrapped", { { "n", n } }, n, opt, [&] {
+                long long visits = 0;
+                for (int i = 0; i < n; ++i)
+                    wrapped.forEachNeighborWrapped(std::min((int)(x[i] / cs), wcells - 1),
+                                                   std::min((int)(y[i] / cs), wcells - 1),
+                                                   wcells, wcells,
+                                                   [&](int j) { visits += j; });
+                doNotOptimize((double)visits);
+            }));
+    }
+}
+
+// ── Cluster::rule ─────────────────────────────────────────────────────────
+// One op = a self-rule plus wrapping boundaries (keeps the state stationary
+// across thousands of repetitions; the boundary pass is O(n) and negligible).
+// "neighbors" is the expected interaction count per particle, n*pi*r^2/area.
+void benchRule(const Options& opt, std::vector<Result>& out) {
+    if (!selected(opt, "Cluster::rule")) return;
+
+    struct Case { int n; float radius; float world; };
+    const std::vector<Case> cases = opt.quick
+        ? std::vector<Case>{ { 1000, 80.f, 1000.f }, { 10000, 80.f, 3162.f } }
+        : std::vector<Case>{
+              {   1000,  80.f, 1000.f },   // sparse-ish, small
+              {  10000,  80.f, 1000.f },   // dense
+              {  10000,  80.f, 3162.f },   // same density as the first case
+              { 100000,  80.f, 3162.f },   // dense, large
+              {  10000,  40.f, 1000.f },   // radius sweep at fixed density
+              {  10000, 160.f, 1000.f },
+          };
+
+    for (const Case& c : cases) {
+        Random::Seed(opt.seed);
+        ParticleLife::Cluster cluster(c.n, ParticleLife::Color::Green());
+        cluster.resize(c.n, 0.f, 0.f, c.world, c.world);
+        const double neighbors = c.n * 3.14159265 * c.radius * c.radius / (c.world * c.world);
+
+        out.push_back(measure("Cluster::rule",
+                              { { "n", c.n }, { "radius", c.radius }, { "world", c.world },
+                                { "neighbors", std::round(neighbors * 10.0) / 10.0 } },
+                              c.n, opt, [&] {
+            cluster.rule(cluster, -30.f, c.radius, 0.5f, 0.f, c.world, c.world, true);
+            cluster.applyBoundariesWrapping(0.f, 0.f, c.world, c.world);
+            doNotOptimize(cluster.posX[0]);
+        }));
+    }
+}
+
+// ── Boids / KNN ───────────────────────────────────────────────────────────
+void benchBoids(const Options& opt, std::vector<Result>& out) {
+    const std::vector<int> sizes = opt.quick ? std::vector<int>{ 500, 2000 }
+                                             : std::vector<int>{ 500, 2000, 5000 };
+    const int w = 1920, h = 1080;
+    const float dt = 1.f / 60.f;
+
+    for (int n : sizes) {
+        if (selected(opt, "BoidSystem::update")) {
+            Random::Seed(opt.seed);
+            BoidSystem boids;
+            boids.generate(n, w, h);
+            out.push_back(measure("BoidSystem::update", { { "n", n } }, n, opt, [&] {
+                boids.update(dt, w, h);
+            }));
+        }
+        if (selected(opt, "BoidSystem::buildGeometry")) {
+            Random::Seed(opt.seed);
+            BoidSystem boids;
+            boids.generate(n, w, h);
+            boids.update(dt, w, h);
+            BoidDrawOptions draw;
+            draw.direction = draw.steering = true;
+            out.push_back(measure("BoidSystem::buildGeometry", { { "n", n } }, n, opt, [&] {
+                doNotOptimize(boids.buildGeometry(draw));
+            }));
+        }
+        if (selected(opt, "ParticleKNNSystem::update")) {
+            Random::Seed(opt.seed);
+            ParticleKNNSystem knn;
+            knn.generate(n, w, h);
+            out.push_back(measure("ParticleKNNSystem::update", { { "n", n } }, n, opt, [&] {
+                FrameArena::Local().reset();
+                knn.update(dt, w, h);
+                doNotOptimize(knn.getConnectionCount());
+            }));
+        }
+    }
+}
+
+// ── Rendering ─────────────────────────────────────────────────────────────
+// CPU render paths for four clusters on a 1920x1080 viewport, without the
+// texture upload: the splat raster and the density map (2 px cells).
+void benchRender(const Options& opt, std::vector<Result>& out) {
+    const bool splat   = selected(opt, "ParticleSplatter::rasterize");
+    const bool density = selected(opt, "DensityMap::render");
+    const bool lines   = selected(opt, "Cluster::drawConnections");
+    if (!splat && !density && !lines) return;
+
+    const std::vector<int> sizes = opt.quick ? std::vector<int>{ 100000 }
+                                             : std::vector<int>{ 100000, 1000000 };
+    Camera2D cam;
+    cam.setViewport(1920.f, 1080.f);
+    cam.fit(0.f, 0.f, 1920.f, 1080.f);
+
+    for (int n : sizes) {
+        Random::Seed(opt.seed);
+        std::vector<float> x[4], y[4];
+        std::vector<ParticleSplatter::Layer> layers;
+        for (int c = 0; c < 4; ++c) {
+            uniformPoints(n / 4, 1920.f, 1080.f, x[c], y[c]);
+            layers.push_back({ x[c].data(), y[c].data(), n / 4,
+                               (Uint8)(64 * c), 255, 128, 255 });
+        }
+
+        if (splat) {
+            for (int radius : { 1, 3 }) {
+                ParticleSplatter splatter;
+                out.push_back(measure("ParticleSplatter::rasterize",
+                                      { { "n", n }, { "radius", radius } }, n, opt, [&] {
+                    splatter.rasterize(layers.data(), (int)layers.size(), radius, cam);
+                    doNotOptimize(splatter.pixels()[0]);
+                }));
+            }
+        }
+        if (density) {
+            DensityMap map;
+            out.push_back(measure("DensityMap::render", { { "n", n } }, n, opt, [&] {
+                map.accumulate(layers.data(), (int)layers.size(), cam, 2);
+                map.colorize(layers.data(), DensityMap::Coloring::ClusterBlend);
+                doNotOptimize(map.count(0, 0, 0));
+            }));
+        }
+        // Edge generation only (radius 20 px, up to 5 links per particle), from
+        // a grid query and from links recorded by a self-rule
+        if (lines && n <= 100000) {
+            ParticleLife::Cluster cluster(n, ParticleLife::Color::Green());
+            cluster.posX = x[0]; cluster.posY = y[0];
+            cluster.velX.assign(n / 4, 0.f); cluster.velY.assign(n / 4, 0.f);
+            LineBatch batch;
+            for (int physics = 0; physics <= 1; ++physics) {
+                cluster.requestLinks(physics ? 20.f : 0.f, 5);
+                if (physics)   // viscosity 1: velocities stay zero, nothing moves
+                    cluster.rule(cluster, 0.f, 40.f, 1.f, 0.f, 1920.f, 1080.f);
+                out.push_back(measure("Cluster::drawConnections",
+                                      { { "n", n / 4 }, { "physics", physics } }, n / 4, opt, [&] {
+                    batch.clear();
+                    cluster.drawConnections(batch, 1920.f, 1080.f, 20.f, 5, cam);
+                    doNotOptimize(batch.size());
+                }));
+            }
+        }
+    }
+}
+
+// ── Audio FFT / MLP ───────────────────────────────────────────────────────
+void benchAudio(const Options& opt, std::vector<Result>& out) {
+    if (selected(opt, "AudioBands::update")) {
+        // Deterministic stereo test signal: two tones plus seeded noise
+        Random::Seed(opt.seed);
+        std::normal_distribution<float> noise(0.f, 0.05f);
+        const int frames = AudioCPPN::FFT_SIZE;
+        std::vector<float> pcm(frames * 2);
+        for (int i = 0; i < frames; ++i) {
+            const float t = i / 44100.f;
+            const float s = 0.5f * std::sin(2.f * 3.14159265f * 110.f * t)
+                          + 0.3f * std::sin(2.f * 3.14159265f * 3000.f * t)
+                          + noise(Random::Engine());
+            pcm[2 * i] = pcm[2 * i + 1] = s;
+        }
+
+        AudioCPPN::AudioBands bands;
+        out.push_back(measure("AudioBands::update", { { "fft", frames } }, frames, opt, [&] {
+            FrameArena::Local().reset();
+            bands.pushSamples(pcm.data(), frames, 2);
+            bands.update();
+            doNotOptimize(bands.getRawBands()[0]);
+        }));
+    }
+
+    if (selected(opt, "SimpleMLP::forward")) {
+        struct Shape { int in, out, hidden, layers; };
+        for (const Shape& s : { Shape{ 8, 32, 32, 3 }, Shape{ 16, 64, 128, 4 } }) {
+            AudioCPPN::SimpleMLP mlp(s.in, s.out, s.hidden, s.layers);
+            mlp.randomiseWeights(1.f, opt.seed);
+            Eigen::VectorXf input = Eigen::VectorXf::LinSpaced(s.in, -1.f, 1.f);
+            std::vector<float> output(s.out);
+            out.push_back(measure("SimpleMLP::forward",
+                                  { { "in", s.in }, { "out", s.out },
+                                    { "hidden", s.hidden }, { "layers", s.layers } },
+                                  1.0, opt, [&] {
+                FrameArena::Local().reset();
+                mlp.forward(input, output.data());
+                doNotOptimize(output[0]);
+            }));
+        }
+    }
+}
+
+} // namespace
+
+void runKernels(const Options& opt, std::vector<Result>& out) {
+    benchGrid(opt, out);
+    benchRule(opt, out);
+    benchBoids(opt, out);
+    benchRender(opt, out);
+    benchAudio(opt, out);
+}
+
+} // namespace Bench
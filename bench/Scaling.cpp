@@ -0,0 +1,147 @@
+#include "Bench.h"
+
+#include "Core/Random.h"
+#include "ParticleLife/ParticleLifeSystem.h"
+
+#include <random>
+#include <cmath>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace Bench {
+
+namespace {
+
+constexpr float  kRadius  = 80.f;
+constexpr float  kMargin  = 50.f;   // ParticleLifeSystem's default margins
+// ~20 particles inside each rule radius, whatever the particle count
+constexpr double kDensity = 20.0 / (3.14159265 * kRadius * kRadius);
+
+int maxThreads(const Options& opt) {
+#ifdef _OPENMP
+    return opt.threads > 0 ? opt.threads : omp_get_max_threads();
+#else
+    (void)opt;
+    return 1;
+#endif
+}
+
+void setThreads(int threads) {
+#ifdef _OPENMP
+    omp_set_num_threads(threads);
+#else
+    (void)threads;
+#endif
+}
+
+// 1, 2, 4, ... up to and including maxT
+std::vector<int> threadCounts(int maxT) {
+    std::vector<int> counts;
+    for (int t = 1; t < maxT; t *= 2) counts.push_back(t);
+    counts.push_back(maxT);
+    return counts;
+}
+
+// Square world whose inner (margin-free) area holds n particles at kDensity
+int worldSide(int n) {
+    return (int)std::ceil(std::sqrt(n / kDensity) + 2.0 * kMargin);
+}
+
+// Four clusters with seeded gravities and a common rule radius, wrapping
+// boundaries. Rebuilt for every measurement so each starts from the same state.
+void buildScenario(ParticleLife::ParticleLifeSystem& system, int n, uint32_t seed) {
+    using namespace ParticleLife;
+    Random::Seed(seed);
+
+    const int side = worldSide(n);
+    system.clear();
+    system.setBoundaryMode(BoundaryMode::Wrapping);
+    system.setWorldSize(side, side);
+
+    const Color colors[] = { Color::Green(), Color::Red(), Color::White(), Color::Yellow() };
+    for (const Color& c : colors) system.addCluster(n / 4, c);
+
+    std::uniform_real_distribution<float> dG(-100.f, 100.f);
+    for (int a = 0; a < 4; ++a)
+        for (int b = 0; b < 4; ++b)
+            system.addRule(a, b, dG(Random::Engine()), kRadius);
+}
+
+// ── Series ────────────────────────────────────────────────────────────────
+// Strong: n fixed, speedup = T1/Tp, efficiency = speedup/p.
+// Weak:   n = p * perThread, efficiency = T1/Tp, scaled speedup = p * T1/Tp.
+struct Point { int threads; int n; };
+
+void runSeries(const Options& opt, const std::string& name, const std::string& title,
+               const std::vector<Point>& points, bool weak, std::vector<Result>& out)
+{
+    std::vector<Result> series;
+    for (const Point& p : points) {
+        setThreads(p.threads);
+        ParticleLife::ParticleLifeSystem system;
+        buildScenario(system, p.n, opt.seed);
+
+        series.push_back(measure(name,
+                                 { { "n", p.n }, { "threads", p.threads },
+                                   { "world", worldSide(p.n) } },
+                                 p.n, opt, [&] {
+            system.update();
+        }));
+    }
+
+    const double t1 = series.front().medianNs;
+    for (size_t k = 0; k < series.size(); ++k) {
+        const int    threads    = points[k].threads;
+        const double ratio      = series[k].medianNs > 0 ? t1 / series[k].medianNs : 0.0;
+        const double speedup    = weak ? ratio * threads : ratio;
+        const double efficiency = weak ? ratio : ratio / threads;
+        series[k].metrics = { { "speedup", speedup }, { "efficiency", efficiency } };
+    }
+
+    if (opt.print) {
+        std::printf("\n  %s\n  %8s %10s %12s %10s %11s\n",
+                    title.c_str(), "threads", "n", "ms/step", "speedup", "efficiency");
+        for (size_t k = 0; k < series.size(); ++k)
+            std::printf("  %8d %10d %12.3f %10.2f %10.1f%%\n",
+                        points[k].threads, points[k].n, series[k].medianNs * 1e-6,
+                        series[k].metrics[0].second, 100.0 * series[k].metrics[1].second);
+        std::printf("\n");
+    }
+
+    for (auto& r : series) out.push_back(std::move(r));
+}
+
+} // namespace
+
+void runScaling(const Options& opt, std::vector<Result>& out) {
+    const int maxT = maxThreads(opt);
+    const std::vector<int> threads = threadCounts(maxT);
+
+    const std::string strongName = "ParticleLife::step strong";
+    if (selected(opt, strongName)) {
+        const std::vector<int> sizes = opt.quick ? std::vector<int>{ 1000, 10000 }
+                                                 : std::vector<int>{ 1000, 10000, 100000, 1000000 };
+        for (int n : sizes) {
+            std::vector<Point> points;
+            for (int t : threads) points.push_back({ t, n });
+            runSeries(opt, strongName, "strong scaling, n = " + std::to_string(n),
+                      points, false, out);
+        }
+    }
+
+    const std::string weakName = "ParticleLife::step weak";
+    if (selected(opt, weakName)) {
+        // 16384 per thread reaches ~1M particles at 64 threads
+        const int perThread = opt.quick ? 2000 : 16384;
+        std::vector<Point> points;
+        for (int t : threads) points.push_back({ t, perThread * t });
+        runSeries(opt, weakName, "weak scaling, " + std::to_string(perThread) + " particles/thread",
+                  points, true, out);
+    }
+
+    setThreads(maxT);
+}
+
+} // namespace Bench
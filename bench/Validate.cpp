@@ -0,0 +1,327 @@
+#include "Bench.h"
+
+#include "Core/Random.h"
+#include "ParticleLife/ParticleLifeSystem.h"
+#include "Core/TrailHistory.h"
+#include "Core/LineBatch.h"
+
+#include <random>
+#include <cmath>
+#include <atomic>
+
+namespace Bench {
+
+namespace {
+
+using ParticleLife::Cluster;
+using ParticleLife::Rule;
+
+constexpr float kMargin    = 50.f;   // ParticleLifeSystem's default margins
+constexpr float kViscosity = 0.5f;
+
+struct World {
+    std::vector<Cluster> clusters;
+    std::vector<Rule>    rules;
+    float w = 0.f, h = 0.f;
+    bool  wrapping = false;
+};
+
+// Four clusters, seeded rules with radii in [30, 120]; the world is sized for
+// roughly 20 particles per 80 px radius so the grid sees realistic occupancy.
+World makeWorld(const ValidationConfig& cfg, uint32_t seed, bool wrapping) {
+    Random::Seed(seed);
+    World world;
+    const int    total = 4 * cfg.perCluster;
+    const double side  = std::sqrt(total * 3.14159265 * 80.0 * 80.0 / 20.0) + 2.0 * kMargin;
+    world.w = world.h  = (float)std::ceil(side);
+    world.wrapping     = wrapping;
+
+    const ParticleLife::Color colors[] = { ParticleLife::Color::Green(), ParticleLife::Color::Red(),
+                                           ParticleLife::Color::White(), ParticleLife::Color::Yellow() };
+    for (const auto& c : colors) {
+        Cluster cluster(cfg.perCluster, c);
+        cluster.resize(cfg.perCluster, kMargin, kMargin, world.w - kMargin, world.h - kMargin);
+        world.clusters.push_back(std::move(cluster));
+    }
+
+    auto& gen = Random::Engine();
+    std::uniform_real_distribution<float> dG(-100.f, 100.f);
+    std::uniform_real_distribution<float> dR(30.f, 120.f);
+    for (int a = 0; a < 4; ++a)
+        for (int b = 0; b < 4; ++b)
+            world.rules.emplace_back(a, b, dG(gen), dR(gen));
+    return world;
+}
+
+// Shortest-path offset on the torus, exactly as Cluster::rule() computes it
+inline void wrapDelta(float& ddx, float& ddy, const World& w) {
+    const float worldW = w.w - 2.f * kMargin, worldH = w.h - 2.f * kMargin;
+    const float halfW  = worldW * 0.5f,       halfH  = worldH * 0.5f;
+    if      (ddx >  halfW) ddx -= worldW;
+    else if (ddx < -halfW) ddx += worldW;
+    if      (ddy >  halfH) ddy -= worldH;
+    else if (ddy < -halfH) ddy += worldH;
+}
+
+// ── Oracle ────────────────────────────────────────────────────────────────
+// Brute-force scalar rule with the semantics of Cluster::rule(): every pair,
+// serial, particles updated in place in index order.
+void referenceRule(Cluster& self, const Cluster& other, const Rule& rule, const World& w) {
+    const int   n    = self.size();
+    const int   m    = other.size();
+    const float g    = rule.gravity / -100.0f;
+    const float r2   = rule.radius * rule.radius;
+    const float damp = 1.0f - kViscosity;
+
+    for (int i = 0; i < n; ++i) {
+        float fx = 0.f, fy = 0.f;
+        const float px = self.posX[i];
+        const float py = self.posY[i];
+        for (int j = 0; j < m; ++j) {
+            float ddx = px - other.posX[j];
+            float ddy = py - other.posY[j];
+            if (w.wrapping) wrapDelta(ddx, ddy, w);
+            const float d2 = ddx * ddx + ddy * ddy;
+            if (d2 > 0.f && d2 < r2) {
+                const float inv_d = 1.f / sqrtf(d2);
+                fx += ddx * inv_d;
+                fy += ddy * inv_d;
+            }
+        }
+        self.velX[i] = (self.velX[i] + fx * g) * damp;
+        self.velY[i] = (self.velY[i] + fy * g) * damp;
+        self.posX[i] += self.velX[i];
+        self.posY[i] += self.velY[i];
+    }
+}
+
+// One ParticleLifeSystem::update() worth of rules plus boundaries
+template<typename RuleFn>
+void step(World& w, RuleFn&& applyRule) {
+    for (const Rule& rule : w.rules)
+        applyRule(w.clusters[rule.clusterA], w.clusters[rule.clusterB], rule);
+    for (auto& c : w.clusters) {
+        if (w.wrapping) c.applyBoundariesWrapping(kMargin, kMargin, w.w - kMargin, w.h - kMargin);
+        else            c.applyBoundariesClamping(kMargin, kMargin, w.w - kMargin, w.h - kMargin);
+    }
+}
+
+// ── Force check ───────────────────────────────────────────────────────────
+struct ForceError {
+    double    maxAbs   = 0.0;
+    double    sumSq    = 0.0;   // squared error
+    double    refSumSq = 0.0;   // squared reference magnitude
+    long long count    = 0;
+};
+
+// Forces Cluster::rule() applies to the current state, against double
+// precision sums over all pairs. The kernel's force is read back from a probe
+// copy with zero velocity, unit gravity and no damping; the radius test is
+// done in float so both sides agree on pairs sitting exactly on the radius.
+void checkForces(const World& w, ForceError& err) {
+    std::vector<double> refX, refY;
+    for (const Rule& rule : w.rules) {
+        const Cluster& self  = w.clusters[rule.clusterA];
+        const Cluster& other = w.clusters[rule.clusterB];
+        const int n = self.size(), m = other.size();
+
+        Cluster probe  = self;
+        Cluster source = other;   // distinct object even for self-rules
+        std::fill(probe.velX.begin(), probe.velX.end(), 0.f);
+        std::fill(probe.velY.begin(), probe.velY.end(), 0.f);
+        probe.rule(source, -100.f, rule.radius, 0.f, 0.f, w.w, w.h, w.wrapping, kMargin, kMargin);
+
+        const float r2 = rule.radius * rule.radius;
+        refX.assign(n, 0.0);
+        refY.assign(n, 0.0);
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < m; ++j) {
+                float ddx = self.posX[i] - other.posX[j];
+                float ddy = self.posY[i] - other.posY[j];
+                if (w.wrapping) wrapDelta(ddx, ddy, w);
+                const float d2 = ddx * ddx + ddy * ddy;
+                if (d2 > 0.f && d2 < r2) {
+                    const double d = std::sqrt((double)ddx * ddx + (double)ddy * ddy);
+                    refX[i] += ddx / d;
+                    refY[i] += ddy / d;
+                }
+            }
+            const double ex = probe.velX[i] - refX[i];
+            const double ey = probe.velY[i] - refY[i];
+            const double e2 = ex * ex + ey * ey;
+            err.maxAbs    = std::max(err.maxAbs, std::sqrt(e2));
+            err.sumSq    += e2;
+            err.refSumSq += refX[i] * refX[i] + refY[i] * refY[i];
+            ++err.count;
+        }
+    }
+}
+
+// Max / RMS distance between matching particles (toroidal when wrapping)
+void divergence(const World& a, const World& b, double& maxD, double& rmsD) {
+    double sum = 0.0;
+    long long count = 0;
+    maxD = 0.0;
+    for (size_t c = 0; c < a.clusters.size(); ++c) {
+        const Cluster& ca = a.clusters[c];
+        const Cluster& cb = b.clusters[c];
+        for (int i = 0; i < ca.size(); ++i) {
+            float dx = ca.posX[i] - cb.posX[i];
+            float dy = ca.posY[i] - cb.posY[i];
+            if (a.wrapping) wrapDelta(dx, dy, a);
+            const double d2 = (double)dx * dx + (double)dy * dy;
+            maxD = std::max(maxD, std::sqrt(d2));
+            sum += d2;
+            ++count;
+        }
+    }
+    rmsD = count ? std::sqrt(sum / count) : 0.0;
+}
+
+// ── Scenario ──────────────────────────────────────────────────────────────
+json runScenario(const Options& opt, const ValidationConfig& cfg, bool wrapping, bool& passed) {
+    World candidate = makeWorld(cfg, opt.seed, wrapping);
+    World reference = candidate;
+
+    ForceError total;
+    json forcePerStep = json::array();
+    json checkpoints  = json::array();
+    double maxD = 0.0, rmsD = 0.0;
+
+    if (opt.print)
+        std::printf("\n  %s, %d particles, %d steps\n  %8s %14s %14s %14s %14s\n",
+                    wrapping ? "wrapping" : "clamping", 4 * cfg.perCluster, cfg.steps,
+                    "step", "max |dF|", "rms |dF|", "max |dx|", "rms |dx|");
+
+    for (int s = 1; s <= cfg.steps; ++s) {
+        ForceError e;
+        checkForces(candidate, e);
+        forcePerStep.push_back(e.maxAbs);
+        total.maxAbs    = std::max(total.maxAbs, e.maxAbs);
+        total.sumSq    += e.sumSq;
+        total.refSumSq += e.refSumSq;
+        total.count    += e.count;
+
+        step(candidate, [&](Cluster& self, const Cluster& other, const Rule& rule) {
+            self.rule(other, rule.gravity, rule.radius, kViscosity, 0.f,
+                      candidate.w, candidate.h, candidate.wrapping, kMargin, kMargin);
+        });
+        step(reference, [&](Cluster& self, const Cluster& other, const Rule& rule) {
+            referenceRule(self, other, rule, reference);
+        });
+
+        // Report steps 1, 10, 100, ... and the last one
+        bool report = s == cfg.steps;
+        for (int p = 1; p <= s && !report; p *= 10) report = p == s;
+        if (report) {
+            divergence(candidate, reference, maxD, rmsD);
+            checkpoints.push_back({ { "step", s }, { "max", maxD }, { "rms", rmsD } });
+            if (opt.print)
+                std::printf("  %8d %14.3e %14.3e %14.3e %14.3e\n", s, e.maxAbs,
+                            e.count ? std::sqrt(e.sumSq / e.count) : 0.0, maxD, rmsD);
+        }
+    }
+
+    const double rmsF = total.count ? std::sqrt(total.sumSq / total.count) : 0.0;
+    const double relF = total.refSumSq > 0.0 ? std::sqrt(total.sumSq / total.refSumSq) : 0.0;
+    const bool forceOk      = total.maxAbs <= cfg.forceTol;
+    const bool divergenceOk = cfg.divergenceTol < 0.0 || maxD <= cfg.divergenceTol;
+    passed = forceOk && divergenceOk;
+
+    if (opt.print)
+        std::printf("  force max %.3e (tol %.1e) rms %.3e rel %.3e -> %s\n",
+                    total.maxAbs, cfg.forceTol, rmsF, relF, passed ? "PASS" : "FAIL");
+
+    return {
+        { "boundary",       wrapping ? "wrapping" : "clamping" },
+        { "particles",      4 * cfg.perCluster },
+        { "steps",          cfg.steps },
+        { "force",          { { "max_abs", total.maxAbs }, { "rms", rmsF }, { "relative_rms", relF } } },
+        { "force_per_step", forcePerStep },
+        { "divergence",     checkpoints },
+        { "passed",         passed }
+    };
+}
+
+// ── Trail history ─────────────────────────────────────────────────────────
+// The GUI can change the trail length or track count between record() and
+// draw(). The next draw must still read the rings as they were recorded:
+// every segment recorded, and no point outside them.
+json runTrailScenario(const Options& opt, bool& passed) {
+    constexpr int kItems = 100, kTracks = 8, kLength = 8, kSteps = 6;
+    struct Change { const char* name; int length, tracks; };
+    const Change changes[] = {
+        { "unchanged",   kLength,     kTracks     },
+        { "longer",      8 * kLength, kTracks     },
+        { "shorter",     2,           kTracks     },
+        { "more tracks", kLength,     4 * kTracks },
+    };
+
+    if (opt.print)
+        std::printf("\n  trail history, %d tracks x %d points, %d records\n  %12s %10s %10s %10s\n",
+                    kTracks, kLength, kSteps, "change", "segments", "expected", "bad points");
+
+    // Item i at record s sits at (1000 i + s, s)
+    const int expected = kTracks * (std::min(kSteps, kLength) - 1);
+    json cases = json::array();
+    passed = true;
+    for (const Change& change : changes) {
+        TrailHistory history;
+        history.setTracks(kTracks);
+        history.setLength(kLength);
+        for (int s = 0; s < kSteps; ++s)
+            history.record(kItems, [&](int i, float& x, float& y) { x = 1000.f * i + s; y = (float)s; });
+
+        history.setLength(change.length);
+        history.setTracks(change.tracks);
+
+        std::atomic<int> bad{ 0 };
+        LineBatch batch;
+        batch.clear();
+        history.draw(batch,
+            [&](float x, float y, float& sx, float& sy) {
+                const int s = (int)y;
+                const int i = (int)std::lround((x - s) / 1000.f);
+                if (y != (float)s || s < 0 || s >= kSteps || i < 0 || i >= kItems
+                    || x != 1000.f * i + s)
+                    ++bad;
+                sx = x;
+                sy = y;
+            },
+            [](int) { return SDL_FColor{ 1.f, 1.f, 1.f, 1.f }; },
+            2000.f);
+
+        const bool ok = batch.size() == expected && bad == 0;
+        passed = passed && ok;
+        if (opt.print)
+            std::printf("  %12s %10d %10d %10d -> %s\n", change.name, batch.size(), expected,
+                        bad.load(), ok ? "PASS" : "FAIL");
+        cases.push_back({ { "change", change.name }, { "segments", batch.size() },
+                          { "expected", expected }, { "bad_points", bad.load() }, { "passed", ok } });
+    }
+    return { { "scenario", "trail history" }, { "cases", cases }, { "passed", passed } };
+}
+
+} // namespace
+
+int runValidation(const Options& opt, const ValidationConfig& cfg, json& report) {
+    int failures = 0;
+    report = {
+        { "seed",                 opt.seed },
+        { "force_tolerance",      cfg.forceTol },
+        { "divergence_tolerance", cfg.divergenceTol },
+        { "scenarios",            json::array() }
+    };
+    for (bool wrapping : { true, false }) {
+        bool passed = false;
+        report["scenarios"].push_back(runScenario(opt, cfg, wrapping, passed));
+        if (!passed) ++failures;
+    }
+    bool trailsPassed = false;
+    report["scenarios"].push_back(runTrailScenario(opt, trailsPassed));
+    if (!trailsPassed) ++failures;
+    report["passed"] = failures == 0;
+    return failures;
+}
+
+} // namespace Bench
@@ -0,0 +1,205 @@
+#include "Bench.h"
+
+#include "Core/Random.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+static void PrintUsage(const char* exe) {
+    std::printf(
+        "Usage: %s [suite] [options]\n"
+        "Suites:\n"
+        "  kernels               microbenchmarks of the core kernels (default)\n"
+        "  scaling               ParticleLife step, strong and weak scaling over 1..threads\n"
+        "  gate                  fixed kernel set compared with a baseline; exit 1 on regression\n"
+        "  validate              Cluster::rule against a brute-force oracle, trail history\n"
+        "                        layout checks; exit 1 on mismatch\n"
+        "Options:\n"
+        "  --filter <text>       only run benchmarks whose name contains text\n"
+        "  --json <file|->       write results as JSON (- for stdout)\n"
+        "  --seed <n>            seed for generated inputs (default 12345)\n"
+        "  --reps <n>            timed samples per benchmark (default 15)\n"
+        "  --warmup <n>          untimed ops before sampling (default 3)\n"
+        "  --min-sample-ms <ms>  minimum duration of one sample (default 20)\n"
+        "  --threads <n>         OpenMP thread count (scaling: highest count tried)\n"
+        "  --quick               smaller sizes and fewer samples\n"
+        "Gate:\n"
+        "  --baseline <file>     baseline JSON (default bench/baselines/gate.json)\n"
+        "  --tolerance <x>       allowed slowdown, 0.15 = 15%% (default: baseline's, else 0.15)\n"
+        "  --update-baseline     write this run as the new baseline instead of comparing\n"
+        "Validate:\n"
+        "  --particles <n>       particles per cluster, four clusters (default 500)\n"
+        "  --steps <n>           steps to run (default 100)\n"
+        "  --force-tol <x>       max per-particle force error (default 1e-3)\n"
+        "  --divergence-tol <x>  fail if positions diverge more than x px (default: report only)\n"
+        "  --help\n", exe);
+}
+
+static int ThreadCount() {
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+int main(int argc, char* argv[]) {
+    Bench::Options opt;
+    std::string suite = "kernels";
+    std::string jsonPath;
+    std::string baselinePath = "bench/baselines/gate.json";
+    double tolerance = -1.0;
+    bool updateBaseline = false;
+    Bench::ValidationConfig validation;
+    int threads = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if      (arg == "--help" || arg == "-h")          { PrintUsage(argv[0]); return 0; }
+        else if (arg == "--quick")                        opt.quick = true;
+        else if (arg == "--filter"        && hasValue)    opt.filter = argv[++i];
+        else if (arg == "--json"          && hasValue)    jsonPath = argv[++i];
+        else if (arg == "--seed"          && hasValue)    opt.seed = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--reps"          && hasValue)    opt.reps = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--warmup"        && hasValue)    opt.warmup = std::max(0, std::atoi(argv[++i]));
+        else if (arg == "--min-sample-ms" && hasValue)    opt.minSampleMs = std::atof(argv[++i]);
+        else if (arg == "--threads"       && hasValue)    threads = std::atoi(argv[++i]);
+        else if (arg == "--baseline"      && hasValue)    baselinePath = argv[++i];
+        else if (arg == "--tolerance"     && hasValue)    tolerance = std::atof(argv[++i]);
+        else if (arg == "--update-baseline")              updateBaseline = true;
+        else if (arg == "--particles"     && hasValue)    validation.perCluster = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--steps"         && hasValue)    validation.steps = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--force-tol"     && hasValue)    validation.forceTol = std::atof(argv[++i]);
+        else if (arg == "--divergence-tol" && hasValue)   validation.divergenceTol = std::atof(argv[++i]);
+        else if (!arg.empty() && arg[0] != '-')           suite = arg;
+        else {
+            std::fprintf(stderr, "Unknown or incomplete argument: %s\n", arg.c_str());
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (opt.quick) {
+        opt.reps        = std::min(opt.reps, 5);
+        opt.minSampleMs = std::min(opt.minSampleMs, 5.0);
+    }
+
+    // The gate reruns under the baseline's seed and thread count unless told otherwise
+    Bench::json baseline;
+    if (suite == "gate" && !updateBaseline) {
+        std::ifstream file(baselinePath);
+        if (!file) {
+            std::fprintf(stderr, "Cannot read baseline %s (create it with --update-baseline)\n",
+                         baselinePath.c_str());
+            return 2;
+        }
+        try {
+            file >> baseline;
+        } catch (const std::exception& e) {
+            std::fprintf(stderr, "Invalid baseline %s: %s\n", baselinePath.c_str(), e.what());
+            return 2;
+        }
+        opt.seed = baseline.value("seed", opt.seed);
+        if (threads <= 0) threads = baseline.value("threads", 0);
+        if (tolerance < 0.0) tolerance = baseline.value("tolerance", 0.15);
+    }
+    if (tolerance < 0.0) tolerance = 0.15;
+
+    opt.threads = threads;
+    if (threads > 0) {
+#ifdef _OPENMP
+        omp_set_num_threads(threads);
+#else
+        std::fprintf(stderr, "--threads ignored: built without OpenMP\n");
+#endif
+    }
+
+    // JSON on stdout replaces the table so it can be piped
+    const bool jsonToStdout = jsonPath == "-";
+    opt.print = !jsonToStdout;
+    Random::Seed(opt.seed);
+
+    if (suite == "validate") {
+        if (opt.print)
+            std::printf("suite validate  seed %u  threads %d\n", opt.seed, ThreadCount());
+        Bench::json report;
+        const int failures = Bench::runValidation(opt, validation, report);
+        report["threads"] = ThreadCount();
+        if (jsonToStdout) {
+            std::cout << report.dump(2) << std::endl;
+        } else if (!jsonPath.empty()) {
+            std::ofstream file(jsonPath);
+            if (!file) {
+                std::fprintf(stderr, "Failed to open %s\n", jsonPath.c_str());
+                return 1;
+            }
+            file << report.dump(2) << std::endl;
+        }
+        return failures > 0 ? 1 : 0;
+    }
+
+    if (opt.print) {
+        std::printf("suite %s  seed %u  threads %d  reps %d  min sample %.0f ms\n\n",
+                    suite.c_str(), opt.seed, ThreadCount(), opt.reps, opt.minSampleMs);
+        Bench::printHeader();
+    }
+
+    std::vector<Bench::Result> results;
+    if (suite == "kernels") {
+        Bench::runKernels(opt, results);
+    } else if (suite == "scaling") {
+        Bench::runScaling(opt, results);
+    } else if (suite == "gate") {
+        Bench::runGate(opt, results);
+        if (!updateBaseline) Bench::confirmRegressions(opt, results, baseline, tolerance);
+    } else {
+        std::fprintf(stderr, "Unknown suite '%s'\n", suite.c_str());
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    Bench::json doc = {
+        { "suite",   suite        },
+        { "seed",    opt.seed     },
+        { "threads", ThreadCount() },
+        { "quick",   opt.quick || suite == "gate" },
+        { "results", Bench::json::array() }
+    };
+    if (suite == "gate") {
+        doc["tolerance"]  = tolerance;
+        doc["regenerate"] = "Baselines are machine-specific. On the machine that runs the gate: "
+                            "ArtificialLifeBench gate --update-baseline --threads 1";
+    }
+    for (const auto& r : results) doc["results"].push_back(r.toJson());
+
+    auto writeDoc = [&](const std::string& path) {
+        std::ofstream file(path);
+        if (!file) {
+            std::fprintf(stderr, "Failed to open %s\n", path.c_str());
+            return false;
+        }
+        file << doc.dump(2) << std::endl;
+        if (opt.print) std::printf("\nWrote %zu results to %s\n", results.size(), path.c_str());
+        return true;
+    };
+
+    if (jsonToStdout)
+        std::cout << doc.dump(2) << std::endl;
+    else if (!jsonPath.empty() && !writeDoc(jsonPath))
+        return 1;
+
+    if (suite == "gate") {
+        if (updateBaseline) return writeDoc(baselinePath) ? 0 : 1;
+        return Bench::compareToBaseline(results, baseline, tolerance, opt.print) > 0 ? 1 : 0;
+    }
+    return 0;
+}
@@ -89,6 +89,12 @@ public:
     // Returns false if not enough audio data has been received yet.
     bool update();
 
+    // Feed interleaved PCM straight into the analysis ring buffer, bypassing
+    // playback (offline analysis, benchmarks). Same path as the audio callback.
+    void pushSamples(const float* pcm, uint32_t frameCount, int channels) {
+        onAudioData(pcm, frameCount, channels);
+    }
+
     // Most recently computed smoothed bands (after update()).
     const std::array<float, NUM_BANDS>& getBands()    const { return smoothed_; }
     const std::array<float, NUM_BANDS>& getRawBands() const { return raw_; }
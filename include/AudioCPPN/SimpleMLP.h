@@ -15,6 +15,10 @@ public:
     // Forward pass — returns outputSize values in (-1, 1).
     Eigen::VectorXf forward(const Eigen::VectorXf& input) const;
 
+    // Allocation-free forward pass: writes outputSize values to `output`.
+    // Hidden activations live in the calling thread's FrameArena.
+    void forward(const Eigen::Ref<const Eigen::VectorXf>& input, float* output) const;
+
     // Re-initialise all weights from N(0, scale). seed=0 uses std::random_device.
     void randomiseWeights(float scale = 1.f, unsigned seed = 0);
 
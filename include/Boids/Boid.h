@@ -46,6 +46,12 @@ struct Boid {
     }
     
     void getTrianglePoints(Eigen::Vector2f& p1, Eigen::Vector2f& p2, Eigen::Vector2f& p3) const {
+        getTrianglePoints(position, p1, p2, p3);
+    }
+
+    // Same shape centred on at (e.g. an interpolated render position)
+    void getTrianglePoints(const Eigen::Vector2f& at,
+                           Eigen::Vector2f& p1, Eigen::Vector2f& p2, Eigen::Vector2f& p3) const {
         // Derive heading from velocity directly — avoids atan2 + 4 trig calls.
         // Wing angle preserved: rotate dir by ±2.5 rad using precomputed constants.
         // cos(2.5) ≈ -0.8011, sin(2.5) ≈ 0.5985
@@ -53,11 +59,11 @@ struct Boid {
         const Eigen::Vector2f dir = velocity.stableNormalized();
         const float half = size * 0.5f;
 
-        p1 = position + dir * size;
-        p2 = position + Eigen::Vector2f(dir.x() * cw - dir.y() * sw,
-                                         dir.x() * sw + dir.y() * cw) * half;
-        p3 = position + Eigen::Vector2f(dir.x() * cw + dir.y() * sw,
-                                        -dir.x() * sw + dir.y() * cw) * half;
+        p1 = at + dir * size;
+        p2 = at + Eigen::Vector2f(dir.x() * cw - dir.y() * sw,
+                                   dir.x() * sw + dir.y() * cw) * half;
+        p3 = at + Eigen::Vector2f(dir.x() * cw + dir.y() * sw,
+                                  -dir.x() * sw + dir.y() * cw) * half;
     }
 };
 
@@ -3,10 +3,29 @@
 #include <SDL3/SDL.h>
 #include "Boids/Boid.h"
 #include "Core/SpatialGrid.h"
+#include "Core/StageTimer.h"
+#include "Core/Random.h"
+#include "Core/Profiler.h"
+#include "Core/AllocTracker.h"
+#include "Core/LineBatch.h"
+#include "Core/TrailHistory.h"
+#include <nlohmann/json.hpp>
+#include <fstream>
+#include <string>
 #include <vector>
 #include <random>
 #include <algorithm>
 
+// What BoidSystem::draw() puts in its vertex array
+struct BoidDrawOptions {
+    bool  filled          = false;   // solid triangles instead of outlines
+    bool  direction       = false;   // heading segment, directionLength px
+    bool  steering        = false;   // acceleration * steeringScale
+    float directionLength = 30.0f;
+    float steeringScale   = 5.0f;
+    float interpolation   = 1.0f;    // 0 = previous update's positions, 1 = current
+};
+
 class BoidSystem {
 private:
     std::vector<Boid> boids;
@@ -16,18 +35,32 @@ private:
     std::vector<float> soaX_, soaY_;
     SpatialGrid        grid_;
 
-    static std::random_device rd;
-    static std::mt19937       gen;
+    StageTimings timings_;
+
+    // Render geometry: a fixed-size block of vertices per boid, so the
+    // blocks can be filled in parallel and share one index pattern
+    std::vector<SDL_Vertex> vertices_;
+    std::vector<int>        indices_;
+    int indexedBoids_ = 0, indexedLayout_ = -1;
+
+    // Positions before the last update, for interpolated drawing
+    std::vector<Eigen::Vector2f> previous_;
+    float wrapJump_ = 540.0f;   // moves longer than this are wrap-arounds (half the screen)
+
+    // Polyline trails of a subset
+    TrailHistory trails_;
+    LineBatch    trailLines_;
 
 public:
     BoidSystem() {
-        gen.seed(rd());
         params.updateSquaredRadii();
     }
 
     void generate(int count, int screenWidth, int screenHeight) {
         boids.clear();
+        previous_.clear();
 
+        auto& gen = Random::Engine();
         std::uniform_real_distribution<float> posX(0.0f, (float)screenWidth);
         std::uniform_real_distribution<float> posY(0.0f, (float)screenHeight);
         std::uniform_real_distribution<float> vel(-80.0f, 80.0f);
@@ -41,6 +74,14 @@ public:
         const int n = (int)boids.size();
         if (n == 0) return;
 
+        PROFILE_ZONE("Boids update");
+        ALLOC_SCOPE("Boids");
+        StageClock clock(timings_);
+
+        previous_.resize(n);
+        for (int i = 0; i < n; ++i) previous_[i] = boids[i].position;
+        wrapJump_ = 0.5f * (float)std::min(screenWidth, screenHeight);
+
         // Extract positions to SoA for grid construction
         soaX_.resize(n);
         soaY_.resize(n);
@@ -58,6 +99,7 @@ public:
         const int cols = std::max(1, (int)((float)screenWidth  / cs) + 2);
         const int rows = std::max(1, (int)((float)screenHeight / cs) + 2);
         grid_.build(soaX_.data(), soaY_.data(), n, cs, cols, rows);
+        clock.lap("grid");
 
         // Single-pass force computation: one grid query per boid accumulates
         // separation, alignment, and cohesion simultaneously
@@ -125,51 +167,158 @@ public:
             }
         }
 
+        clock.lap("forces");
+
         // Physics update — separate pass intentional to prevent same-frame bias
         for (auto& boid : boids)
             boid.update(deltaTime, screenWidth, screenHeight);
-    }
+        clock.lap("integrate");
 
-    void draw(SDL_Renderer* renderer) {
-        SDL_SetRenderDrawColor(renderer, 0, 255, 255, 255);
+        if (trails_.getTracks() > 0) {
+            trails_.record(n, [&](int i, float& x, float& y) {
+                x = boids[i].position.x();
+                y = boids[i].position.y();
+            });
+            clock.lap("trails");
+        }
+    }
 
-        for (const auto& boid : boids) {
-            Eigen::Vector2f p1, p2, p3;
-            boid.getTrianglePoints(p1, p2, p3);
+    // Bodies plus the optional direction and steering segments, generated in
+    // one parallel pass and submitted with a single SDL_RenderGeometry call.
+    // The heading comes from the normalised velocity (no trig per boid).
+    void draw(SDL_Renderer* renderer, const BoidDrawOptions& opt = {}) {
+        drawTrails(renderer);
+        const int indexCount = buildGeometry(opt);
+        if (indexCount == 0) return;
+        PROFILE_ZONE("Submit boids");
+        SDL_RenderGeometry(renderer, nullptr, vertices_.data(), (int)vertices_.size(),
+                           indices_.data(), indexCount);
+    }
 
-            SDL_RenderLine(renderer, p1.x(), p1.y(), p2.x(), p2.y());
-            SDL_RenderLine(renderer, p2.x(), p2.y(), p3.x(), p3.y());
-            SDL_RenderLine(renderer, p3.x(), p3.y(), p1.x(), p1.y());
-        }
+    // Recorded trails underneath the bodies
+    void drawTrails(SDL_Renderer* renderer) {
+        if (trails_.getTracks() == 0) return;
+        PROFILE_ZONE("Draw trails");
+        trailLines_.clear();
+        trails_.draw(trailLines_,
+            [](float x, float y, float& sx, float& sy) { sx = x; sy = y; },
+            [](int) { return SDL_FColor{ 0.f, 0.6f, 1.f, 0.8f }; },
+            wrapJump_);
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+        trailLines_.flush(renderer);
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
     }
 
-    void drawDirectionVectors(SDL_Renderer* renderer, float length = 30.0f) {
-        SDL_SetRenderDrawColor(renderer, 255, 255, 0, 255);
+    // Fills the vertex and index arrays for draw(); returns the index count
+    int buildGeometry(const BoidDrawOptions& opt = {}) {
+        PROFILE_ZONE("Build boid geometry");
+        const int n = (int)boids.size();
+        if (n == 0) return 0;
+
+        // Per boid: filled body 3 vertices, outlined body 3 quads; +1 quad per segment
+        const int bodyV = opt.filled ? 3 : 12;
+        const int bodyI = opt.filled ? 3 : 18;
+        const int perV  = bodyV + (opt.direction ? 4 : 0) + (opt.steering ? 4 : 0);
+        const int perI  = bodyI + (opt.direction ? 6 : 0) + (opt.steering ? 6 : 0);
+        buildIndices(n, opt, perV, perI, bodyV);
+        vertices_.resize((size_t)n * perV);
+
+        const SDL_FColor body  = { 0.f, 1.f, 1.f, 1.f };
+        const SDL_FColor dirC  = { 1.f, 1.f, 0.f, 1.f };
+        const SDL_FColor steer = { 1.f, 0.f, 1.f, 1.f };
+        const bool blend = opt.interpolation < 1.f && (int)previous_.size() == n;
 
-        for (const auto& boid : boids) {
-            float angle = boid.getHeading();
-            float endX  = boid.position.x() + std::cos(angle) * length;
-            float endY  = boid.position.y() + std::sin(angle) * length;
-            SDL_RenderLine(renderer,
-                           boid.position.x(), boid.position.y(), endX, endY);
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < n; ++i) {
+            const Boid& boid = boids[i];
+            SDL_Vertex* v = &vertices_[(size_t)i * perV];
+
+            // Between the previous and current position, except across a wrap
+            Eigen::Vector2f at = boid.position;
+            if (blend) {
+                const Eigen::Vector2f d = boid.position - previous_[i];
+                if (std::fabs(d.x()) < wrapJump_ && std::fabs(d.y()) < wrapJump_)
+                    at = previous_[i] + d * opt.interpolation;
+            }
+
+            Eigen::Vector2f p1, p2, p3;
+            boid.getTrianglePoints(at, p1, p2, p3);
+            if (opt.filled) {
+                v[0] = { { p1.x(), p1.y() }, body, { 0.f, 0.f } };
+                v[1] = { { p2.x(), p2.y() }, body, { 0.f, 0.f } };
+                v[2] = { { p3.x(), p3.y() }, body, { 0.f, 0.f } };
+            } else {
+                LineBatch::Quad(v,     p1.x(), p1.y(), p2.x(), p2.y(), body, body);
+                LineBatch::Quad(v + 4, p2.x(), p2.y(), p3.x(), p3.y(), body, body);
+                LineBatch::Quad(v + 8, p3.x(), p3.y(), p1.x(), p1.y(), body, body);
+            }
+            v += bodyV;
+
+            const float px = at.x(), py = at.y();
+            if (opt.direction) {
+                const Eigen::Vector2f d = boid.velocity.stableNormalized() * opt.directionLength;
+                LineBatch::Quad(v, px, py, px + d.x(), py + d.y(), dirC, dirC);
+                v += 4;
+            }
+            if (opt.steering) {
+                // Below the old 0.01 threshold the segment collapses to a point
+                const Eigen::Vector2f a = boid.acceleration.squaredNorm() < 1e-4f
+                    ? Eigen::Vector2f(0.f, 0.f) : Eigen::Vector2f(boid.acceleration * opt.steeringScale);
+                LineBatch::Quad(v, px, py, px + a.x(), py + a.y(), steer, steer);
+            }
         }
+        return n * perI;
     }
 
-    void drawSteeringVectors(SDL_Renderer* renderer, float scale = 5.0f) {
-        SDL_SetRenderDrawColor(renderer, 255, 0, 255, 255);
+    // Reads parameters and the boid count from a preset JSON:
+    // { "count", "separationRadius", "alignmentRadius", "cohesionRadius",
+    //   "separationWeight", "alignmentWeight", "cohesionWeight" }
+    // Missing keys keep their current value. Does not regenerate the flock.
+    bool loadFromFile(const std::string& path, int& count) {
+        std::ifstream file(path);
+        if (!file.is_open()) return false;
 
-        for (const auto& boid : boids) {
-            if (boid.acceleration.norm() < 0.01f) continue;
-            float endX = boid.position.x() + boid.acceleration.x() * scale;
-            float endY = boid.position.y() + boid.acceleration.y() * scale;
-            SDL_RenderLine(renderer,
-                           boid.position.x(), boid.position.y(), endX, endY);
-        }
+        nlohmann::json j;
+        try { file >> j; }
+        catch (const nlohmann::json::exception&) { return false; }
+
+        count = j.value("count", count);
+        params.separationRadius = j.value("separationRadius", params.separationRadius);
+        params.alignmentRadius  = j.value("alignmentRadius",  params.alignmentRadius);
+        params.cohesionRadius   = j.value("cohesionRadius",   params.cohesionRadius);
+        params.separationWeight = j.value("separationWeight", params.separationWeight);
+        params.alignmentWeight  = j.value("alignmentWeight",  params.alignmentWeight);
+        params.cohesionWeight   = j.value("cohesionWeight",   params.cohesionWeight);
+        params.updateSquaredRadii();
+        return true;
     }
 
     int              getCount()      const { return (int)boids.size(); }
+    const std::vector<SDL_Vertex>& getVertices() const { return vertices_; }
+    TrailHistory&    getTrailHistory()     { return trails_; }
     BoidParameters&  getParameters()       { return params; }
-};
+    const StageTimings& getStageTimings() const { return timings_; }
 
-inline std::random_device BoidSystem::rd;
-inline std::mt19937       BoidSystem::gen(BoidSystem::rd());
+private:
+    // Same pattern for every boid, offset by its vertex block; rebuilt only
+    // when the count or the layout changes
+    void buildIndices(int n, const BoidDrawOptions& opt, int perV, int perI, int bodyV) {
+        const int layout = (opt.filled ? 1 : 0) | (opt.direction ? 2 : 0) | (opt.steering ? 4 : 0);
+        if (n == indexedBoids_ && layout == indexedLayout_) return;
+        indexedBoids_  = n;
+        indexedLayout_ = layout;
+
+        std::vector<int> pattern;
+        auto quad = [&](int v) { pattern.insert(pattern.end(), { v, v + 1, v + 2, v + 2, v + 3, v }); };
+        if (opt.filled) pattern.insert(pattern.end(), { 0, 1, 2 });
+        else            { quad(0); quad(4); quad(8); }
+        int next = bodyV;
+        if (opt.direction) { quad(next); next += 4; }
+        if (opt.steering)  quad(next);
+
+        indices_.resize((size_t)n * perI);
+        for (int i = 0; i < n; ++i)
+            for (int k = 0; k < perI; ++k)
+                indices_[(size_t)i * perI + k] = i * perV + pattern[k];
+    }
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+// Compile-time switch (CMake option ENABLE_ALLOC_TRACKING). When 0 the
+// global allocation functions are left alone and ALLOC_SCOPE expands to
+// nothing.
+#ifndef ALIFE_ALLOC_TRACKING
+#define ALIFE_ALLOC_TRACKING 0
+#endif
+
+/**
+ * Opt-in heap allocation counter.
+ *
+ * When compiled in, the global allocation functions are replaced (the malloc
+ * family on glibc, so Eigen's aligned_malloc and C libraries are counted too;
+ * operator new/delete elsewhere) and every allocation is charged to the
+ * calling thread's current tag, set with ALLOC_SCOPE("KNN"). Scopes nest; the
+ * innermost wins. Allocations outside any scope, including those made by
+ * OpenMP workers, land in "other".
+ *
+ * Once per frame the main thread calls EndFrame(), which turns the running
+ * totals into per-frame counts. The goal is zero allocations per frame in
+ * every tag once the simulation has reached steady state.
+ */
+class AllocTracker {
+public:
+    static constexpr int MaxTags      = 32;
+    static constexpr int WarmupFrames = 30;   // excluded from steady-state stats
+
+    struct Counters {
+        uint64_t allocs = 0;
+        uint64_t bytes  = 0;
+        uint64_t frees  = 0;
+    };
+
+    static constexpr bool IsCompiledIn() { return ALIFE_ALLOC_TRACKING != 0; }
+
+    // Interns a tag name (string literal); the same name always maps to the
+    // same index. Index 0 is "other".
+    static int RegisterTag(const char* name);
+
+    // Sets the calling thread's tag and returns the previous one
+    static int SetThreadTag(int tag);
+
+    // Called by the allocation hooks
+    static void RecordAlloc(size_t bytes);
+    static void RecordFree();
+
+    // Main thread, once per frame
+    static void EndFrame();
+
+    static int         GetTagCount();
+    static const char* GetTagName(int tag);
+    static Counters    GetLastFrame(int tag);
+
+    // ImGui window: per-tag allocations in the last frame and in steady state
+    static void DrawPanel(bool* open = nullptr);
+
+    // Steady-state allocations per frame for each tag, on stdout
+    static void PrintSummary();
+};
+
+// RAII tag for the current thread
+class AllocScope {
+private:
+    int prev_;
+
+public:
+    explicit AllocScope(int tag) : prev_(AllocTracker::SetThreadTag(tag)) {}
+    ~AllocScope() { AllocTracker::SetThreadTag(prev_); }
+
+    AllocScope(const AllocScope&) = delete;
+    AllocScope& operator=(const AllocScope&) = delete;
+};
+
+#define ALIFE_ALLOC_CONCAT_(a, b) a##b
+#define ALIFE_ALLOC_CONCAT(a, b)  ALIFE_ALLOC_CONCAT_(a, b)
+
+#if ALIFE_ALLOC_TRACKING
+#define ALLOC_SCOPE(name)                                                                   \
+    static const int ALIFE_ALLOC_CONCAT(allocTag_, __LINE__) = AllocTracker::RegisterTag(name); \
+    AllocScope ALIFE_ALLOC_CONCAT(allocScope_, __LINE__)(ALIFE_ALLOC_CONCAT(allocTag_, __LINE__))
+#else
+#define ALLOC_SCOPE(name) ((void)0)
+#endif
@@ -3,8 +3,14 @@
 #include <SDL3/SDL.h>
 #include <string>
 #include <memory>
+#include <vector>
 
 #include "Recorder.h"
+#include "StageTimer.h"
+#include "Time.h"
+#include <algorithm>
+
+class TrailHistory;
 
 // Application configuration
 struct ApplicationConfig {
@@ -13,6 +19,13 @@ struct ApplicationConfig {
     int height = 1080;
     bool resizable = true;
     bool vsync = true;
+
+    // Scenario / benchmark options (usually set from the command line)
+    std::string presetPath;      // loaded by the application in OnStart if set
+    int particleCount = 0;       // 0 = application default (per cluster for Particle Life)
+    int maxFrames = 0;           // > 0: quit after this many frames
+    bool timingSummary = false;  // print per-stage frame timings at exit
+    int maxFixedSteps = 5;       // fixed updates per frame before the backlog is dropped
 };
 
 // Main Application class - Singleton pattern like Unity
@@ -28,8 +41,33 @@ private:
     int screenWidth;
     int screenHeight;
 
+    ApplicationConfig config_;
+
     Recorder recorder_;
     bool screenshotRequested_ = false;
+    bool showProfiler_ = false;       // F6
+
+    // Frame stage timings (last complete frame, and the one in progress)
+    // and their running totals
+    StageTimings frameTimings_;
+    StageTimings frameClock_;
+    StageTotals  frameTotals_;
+    std::vector<float> frameMs_;   // only filled when config_.timingSummary
+
+    // Trails (F7): frames are drawn into a persistent target that is faded
+    // toward the background instead of cleared, then copied to the window
+    bool          trails_       = false;
+    float         trailFade_    = 0.08f;   // background alpha blended per frame
+    SDL_Texture*  trailTarget_  = nullptr;
+    int           trailW_ = 0, trailH_ = 0;
+
+    // Fixed-timestep accumulator: scaled frame time not yet simulated
+    float fixedAccumulator_ = 0.f;
+    int   fixedSteps_       = 0;     // OnFixedUpdate calls in the last frame
+
+    void PrintTimingSummary() const;
+    bool BeginTrails();
+    void EndTrails();
     
 protected:
     Application() = default;
@@ -37,6 +75,10 @@ protected:
     // Provides access to the recorder for derived classes (e.g. to set audio source).
     Recorder& GetRecorder() { return recorder_; }
 
+    // Trail checkbox and fade slider for the derived class's panel, plus the
+    // polyline controls of history when the simulation keeps one.
+    void TrailControls(TrailHistory* history = nullptr);
+
 
 public:
     // Singleton access
@@ -63,10 +105,24 @@ public:
     SDL_Window* GetWindow() const { return window; }
     int GetScreenWidth() const { return screenWidth; }
     int GetScreenHeight() const { return screenHeight; }
+    const ApplicationConfig& GetConfig() const { return config_; }
+    const StageTimings& GetFrameTimings() const { return frameTimings_; }   // last complete frame
     bool IsRunning() const { return isRunning; }
+
+    // Fraction of a fixed step that has elapsed since the last OnFixedUpdate,
+    // for blending the previous and current simulation state when rendering
+    float GetInterpolationAlpha() const {
+        const float dt = Time::FixedDeltaTime();
+        return dt > 0.f ? std::min(fixedAccumulator_ / dt, 1.f) : 1.f;
+    }
+    int GetFixedSteps() const { return fixedSteps_; }
     bool IsRecording()  const { return recorder_.isRecording();  }
     bool IsConverting() const { return recorder_.isConverting(); }
     void RequestScreenshot() { screenshotRequested_ = true; }
+    bool  GetTrails()    const { return trails_;    }
+    float GetTrailFade() const { return trailFade_; }
+    void  SetTrails(bool on);
+    void  SetTrailFade(float a) { trailFade_ = a < 0.f ? 0.f : (a > 1.f ? 1.f : a); }
     
     // Update screen size
     void UpdateScreenSize();
@@ -76,6 +132,10 @@ public:
     
     // Virtual methods for game loop (override in derived class)
     virtual void OnStart() {}
+    // Called zero or more times per frame, before OnUpdate, with a constant
+    // step of Time::FixedDeltaTime(): simulation speed does not depend on
+    // the frame rate. Render with GetInterpolationAlpha() to hide the beat.
+    virtual void OnFixedUpdate(float fixedDeltaTime) {}
     virtual void OnUpdate(float deltaTime) {}
     virtual void OnRender() {}
     virtual void OnGUI() {}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <algorithm>
+
+// 2D pan/zoom camera mapping world coordinates to screen pixels.
+// (centerX, centerY) is the world point shown at the middle of the viewport;
+// zoom is screen pixels per world unit.
+struct Camera2D {
+    float centerX = 0.f;
+    float centerY = 0.f;
+    float zoom    = 1.f;
+
+    float minZoom = 0.01f;
+    float maxZoom = 50.f;
+
+    // Viewport size in pixels (kept in sync with the window by the owner).
+    float viewW = 1920.f;
+    float viewH = 1080.f;
+
+    void setViewport(float w, float h) { viewW = w; viewH = h; }
+
+    float worldToScreenX(float x) const { return (x - centerX) * zoom + viewW * 0.5f; }
+    float worldToScreenY(float y) const { return (y - centerY) * zoom + viewH * 0.5f; }
+    float screenToWorldX(float x) const { return (x - viewW * 0.5f) / zoom + centerX; }
+    float screenToWorldY(float y) const { return (y - viewH * 0.5f) / zoom + centerY; }
+
+    // Visible world rectangle [x0,x1] x [y0,y1].
+    void visibleRect(float& x0, float& y0, float& x1, float& y1) const {
+        const float hw = viewW * 0.5f / zoom;
+        const float hh = viewH * 0.5f / zoom;
+        x0 = centerX - hw;  x1 = centerX + hw;
+        y0 = centerY - hh;  y1 = centerY + hh;
+    }
+
+    // Pan by a screen-space delta (e.g. mouse drag in pixels).
+    void panPixels(float dx, float dy) {
+        centerX -= dx / zoom;
+        centerY -= dy / zoom;
+    }
+
+    // Multiply zoom by `factor`, keeping the world point under (sx, sy) fixed.
+    void zoomAt(float sx, float sy, float factor) {
+        const float wx = screenToWorldX(sx);
+        const float wy = screenToWorldY(sy);
+        zoom = std::clamp(zoom * factor, minZoom, maxZoom);
+        centerX = wx - (sx - viewW * 0.5f) / zoom;
+        centerY = wy - (sy - viewH * 0.5f) / zoom;
+    }
+
+    // Center on a world rectangle and zoom so that it fits the viewport.
+    void fit(float x0, float y0, float x1, float y1) {
+        centerX = (x0 + x1) * 0.5f;
+        centerY = (y0 + y1) * 0.5f;
+        const float w = std::max(x1 - x0, 1.f);
+        const float h = std::max(y1 - y0, 1.f);
+        zoom = std::clamp(std::min(viewW / w, viewH / h), minZoom, maxZoom);
+    }
+};
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+// Orbit camera projecting 3D world points onto the 2D SDL renderer.
+// The camera circles `target` at `distance`, oriented by yaw/pitch (radians).
+// Perspective uses a pinhole with vertical field of view `fovY`; orthographic
+// maps `orthoHeight` world units to the viewport height.
+struct Camera3D {
+    enum class Projection { Orthographic, Perspective };
+
+    float targetX = 0.f, targetY = 0.f, targetZ = 0.f;
+    float yaw      = 0.6f;
+    float pitch    = 0.4f;
+    float distance = 2000.f;
+
+    Projection projection  = Projection::Perspective;
+    float      fovY        = 1.0f;    // ~57 degrees
+    float      orthoHeight = 1500.f;
+    float      nearPlane   = 1.f;
+
+    float viewW = 1920.f;
+    float viewH = 1080.f;
+
+    // Camera basis, refreshed by update() — call once per frame before project().
+    float rx = 1.f, ry = 0.f, rz = 0.f;   // right
+    float ux = 0.f, uy = 1.f, uz = 0.f;   // up
+    float fx = 0.f, fy = 0.f, fz = 1.f;   // forward (into the screen)
+    float eyeX = 0.f, eyeY = 0.f, eyeZ = 0.f;
+    float focal = 1.f;                    // pixels per unit at depth 1 (perspective)
+
+    void setViewport(float w, float h) { viewW = w; viewH = h; }
+
+    void orbit(float dYaw, float dPitch) {
+        yaw  += dYaw;
+        pitch = std::clamp(pitch + dPitch, -1.55f, 1.55f);
+    }
+
+    void dolly(float factor) {
+        distance    = std::max(distance * factor, 1.f);
+        orthoHeight = std::max(orthoHeight * factor, 1.f);
+    }
+
+    void update() {
+        const float cp = std::cos(pitch), sp = std::sin(pitch);
+        const float cy = std::cos(yaw),   sy = std::sin(yaw);
+
+        // Forward points from the eye toward the target
+        fx = -cp * sy;  fy = -sp;  fz = -cp * cy;
+        eyeX = targetX - fx * distance;
+        eyeY = targetY - fy * distance;
+        eyeZ = targetZ - fz * distance;
+
+        // right = normalize(forward x worldUp(0,1,0)) ; up = right x forward
+        rx = -fz;  ry = 0.f;  rz = fx;
+        const float rl = std::sqrt(rx * rx + rz * rz);
+        if (rl > 1e-6f) { rx /= rl; rz /= rl; } else { rx = 1.f; rz = 0.f; }
+        ux = ry * fz - rz * fy;
+        uy = rz * fx - rx * fz;
+        uz = rx * fy - ry * fx;
+
+        focal = 0.5f * viewH / std::tan(0.5f * fovY);
+    }
+
+    // Projects a world point. Returns false when it is behind the near plane.
+    //   sx, sy : screen pixels      depth : distance along the view axis
+    //   scale  : pixels per world unit at that depth (for sizing sprites)
+    bool project(float x, float y, float z,
+                 float& sx, float& sy, float& depth, float& scale) const
+    {
+        const float dx = x - eyeX, dy = y - eyeY, dz = z - eyeZ;
+        const float cx = dx * rx + dy * ry + dz * rz;
+        const float cy = dx * ux + dy * uy + dz * uz;
+        depth          = dx * fx + dy * fy + dz * fz;
+
+        if (projection == Projection::Perspective) {
+            if (depth < nearPlane) return false;
+            scale = focal / depth;
+        } else {
+            scale = viewH / orthoHeight;
+        }
+        // Screen Y grows downward
+        sx = viewW * 0.5f + cx * scale;
+        sy = viewH * 0.5f - cy * scale;
+        return true;
+    }
+};
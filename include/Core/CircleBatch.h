@@ -0,0 +1,122 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+/**
+ * Filled circles drawn with a single SDL_RenderGeometry call.
+ *
+ * Every circle is a textured quad cut from a shared atlas that holds one
+ * sprite per integer radius 0..MaxRadius. Each sprite is the scanline mask
+ * the per-line renderer used to draw (half-width sqrt(r² - dy²) per row),
+ * sampled with nearest filtering, so a batch looks the same as the old
+ * SDL_RenderLine loop while costing one call instead of 2r+1 per particle.
+ * Radii above MaxRadius stretch the largest sprite.
+ *
+ * Per frame: clear(), add() each visible circle in draw order, flush().
+ * The vertex and index arrays keep their capacity between frames.
+ */
+class CircleBatch {
+public:
+    static constexpr int MaxRadius = 64;
+
+    void clear()       { vertices_.clear(); }
+    int  size() const  { return (int)vertices_.size() / 4; }
+
+    // Centre is truncated to whole pixels like the scanline renderer did;
+    // radius <= 1 is a single pixel.
+    void add(float cx, float cy, int radius, const SDL_FColor& color) {
+        const Atlas::Sprite& s = GetAtlas().sprites[radius <= 1 ? 0 : std::min(radius, MaxRadius)];
+        const int   r  = radius <= 1 ? 0 : radius;
+        const float x0 = (float)((int)cx - r), x1 = (float)((int)cx + r + 1);
+        const float y0 = (float)((int)cy - r), y1 = (float)((int)cy + r + 1);
+        vertices_.push_back({ { x0, y0 }, color, { s.u0, s.v0 } });
+        vertices_.push_back({ { x1, y0 }, color, { s.u1, s.v0 } });
+        vertices_.push_back({ { x1, y1 }, color, { s.u1, s.v1 } });
+        vertices_.push_back({ { x0, y1 }, color, { s.u0, s.v1 } });
+    }
+
+    void flush(SDL_Renderer* renderer) {
+        const int count = size();
+        if (count == 0) return;
+        SDL_Texture* texture = GetTexture(renderer);
+        if (!texture) return;
+
+        // Quads share one index pattern; extend it only when the batch grows
+        for (int q = (int)indices_.size() / 6; q < count; ++q) {
+            const int v = q * 4;
+            indices_.insert(indices_.end(), { v, v + 1, v + 2, v + 2, v + 3, v });
+        }
+        SDL_RenderGeometry(renderer, texture, vertices_.data(), count * 4,
+                           indices_.data(), count * 6);
+    }
+
+    static SDL_FColor ToFColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+        return { r / 255.f, g / 255.f, b / 255.f, a / 255.f };
+    }
+
+private:
+    std::vector<SDL_Vertex> vertices_;
+    std::vector<int>        indices_;
+
+    // ── Atlas ─────────────────────────────────────────────────────────────
+    // Sprites packed left to right in shelves; radii 0..64 need 2048 x 343.
+    struct Atlas {
+        static constexpr int Width  = 2048;
+        static constexpr int Height = 384;
+
+        struct Sprite {
+            int   x, y;
+            float u0, v0, u1, v1;
+        };
+        Sprite sprites[MaxRadius + 1];
+    };
+
+    static const Atlas& GetAtlas() {
+        static const Atlas atlas = [] {
+            Atlas a{};
+            int x = 0, y = 0, shelf = 0;
+            for (int r = 0; r <= MaxRadius; ++r) {
+                const int size = 2 * r + 1;
+                if (x + size > Atlas::Width) { x = 0; y += shelf; shelf = 0; }
+                a.sprites[r] = { x, y,
+                                 (float)x / Atlas::Width,          (float)y / Atlas::Height,
+                                 (float)(x + size) / Atlas::Width, (float)(y + size) / Atlas::Height };
+                x    += size;
+                shelf = std::max(shelf, size);
+            }
+            return a;
+        }();
+        return atlas;
+    }
+
+    // White sprites with alpha coverage; the vertex colour tints them. One
+    // texture per process, rebuilt if a different renderer asks for it.
+    static SDL_Texture* GetTexture(SDL_Renderer* renderer) {
+        static SDL_Renderer* owner   = nullptr;
+        static SDL_Texture*  texture = nullptr;
+        if (owner == renderer) return texture;
+
+        std::vector<Uint32> pixels((size_t)Atlas::Width * Atlas::Height, 0u);
+        const Atlas& atlas = GetAtlas();
+        for (int r = 0; r <= MaxRadius; ++r) {
+            const Atlas::Sprite& s = atlas.sprites[r];
+            for (int dy = -r; dy <= r; ++dy) {
+                const int half = (int)sqrtf((float)(r * r - dy * dy));
+                Uint32* row = &pixels[(size_t)(s.y + dy + r) * Atlas::Width + s.x + r];
+                std::fill(row - half, row + half + 1, 0xFFFFFFFFu);
+            }
+        }
+
+        texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC,
+                                    Atlas::Width, Atlas::Height);
+        owner = renderer;
+        if (!texture) return nullptr;
+        SDL_UpdateTexture(texture, nullptr, pixels.data(), Atlas::Width * (int)sizeof(Uint32));
+        SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+        SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
+        return texture;
+    }
+};
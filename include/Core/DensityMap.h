@@ -0,0 +1,165 @@
+#pragma once
+
+#include "Core/Camera2D.h"
+#include "Core/Profiler.h"
+#include "Core/StreamingTexture.h"
+#include "Core/ParticleSplatter.h"
+#include <SDL3/SDL.h>
+#include <vector>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+/**
+ * Density render mode for very large particle counts.
+ *
+ * accumulate() counts the particles of each layer (cluster) per screen cell
+ * of cellPixels x cellPixels; this is the only O(particles) step and runs
+ * in parallel. colorize() turns the counts into one RGBA pixel per cell,
+ * O(cells) regardless of the particle count:
+ *   ClusterBlend - count-weighted mix of the layer colours
+ *   Heat         - total count through an inferno-like colour ramp
+ * Both map log(1 + count) / log(1 + max count), so sparse regions stay
+ * visible next to dense clumps. present() draws the cell texture stretched
+ * over the viewport with linear filtering.
+ */
+class DensityMap {
+public:
+    using Layer = ParticleSplatter::Layer;
+
+    enum class Coloring {
+        ClusterBlend,
+        Heat,
+    };
+
+    void accumulate(const Layer* layers, int layerCount, const Camera2D& cam, int cellPixels) {
+        PROFILE_ZONE("Density bin");
+        cellPixels_ = std::max(1, cellPixels);
+        cols_ = std::max(1, ((int)cam.viewW + cellPixels_ - 1) / cellPixels_);
+        rows_ = std::max(1, ((int)cam.viewH + cellPixels_ - 1) / cellPixels_);
+        layerCount_ = layerCount;
+
+        const size_t cells = (size_t)cols_ * rows_;
+        counts_.assign(cells * layerCount, 0u);
+
+        const float inv = 1.f / cellPixels_;
+        for (int l = 0; l < layerCount; ++l) {
+            const Layer& layer = layers[l];
+            Uint32* counts = &counts_[cells * l];
+            #pragma omp parallel for schedule(static)
+            for (int i = 0; i < layer.count; ++i) {
+                const float sx = cam.worldToScreenX(layer.x[i]) * inv;
+                const float sy = cam.worldToScreenY(layer.y[i]) * inv;
+                if (sx < 0.f || sy < 0.f || sx >= cols_ || sy >= rows_) continue;
+                const size_t cell = (size_t)(int)sy * cols_ + (int)sx;
+                #pragma omp atomic
+                ++counts[cell];
+            }
+        }
+    }
+
+    void colorize(const Layer* layers, Coloring coloring) {
+        PROFILE_ZONE("Density color");
+        const int    cells = cols_ * rows_;
+        const size_t plane = (size_t)cells;
+        pixels_.resize(cells);
+        totals_.resize(cells);
+
+        Uint32 maxCount = 0;
+        #pragma omp parallel for reduction(max:maxCount) schedule(static)
+        for (int cell = 0; cell < cells; ++cell) {
+            Uint32 sum = 0;
+            for (int l = 0; l < layerCount_; ++l) sum += counts_[plane * l + cell];
+            totals_[cell] = sum;
+            maxCount = std::max(maxCount, sum);
+        }
+        const float scale = maxCount > 0 ? 1.f / std::log1p((float)maxCount) : 0.f;
+
+        const auto& ramp = HeatRamp();
+        const auto& logs = LogTable();
+        #pragma omp parallel for schedule(static)
+        for (int cell = 0; cell < cells; ++cell) {
+            const Uint32 n = totals_[cell];
+            if (n == 0) { pixels_[cell] = 0u; continue; }
+            const float k = (n < logs.size() ? logs[n] : std::log1p((float)n)) * scale;
+
+            if (coloring == Coloring::Heat) {
+                pixels_[cell] = ramp[std::min(255, (int)(k * 255.f))];
+                continue;
+            }
+            float r = 0.f, g = 0.f, b = 0.f;
+            for (int l = 0; l < layerCount_; ++l) {
+                const float w = (float)counts_[plane * l + cell];
+                r += w * layers[l].r;
+                g += w * layers[l].g;
+                b += w * layers[l].b;
+            }
+            const float norm = 1.f / n;
+            pixels_[cell] = pack((Uint8)(r * norm), (Uint8)(g * norm), (Uint8)(b * norm),
+                                 (Uint8)(std::max(k, 0.1f) * 255.f));
+        }
+    }
+
+    void present(SDL_Renderer* renderer) {
+        if (pixels_.empty()) return;
+        PROFILE_ZONE("Density upload");
+        if (!texture_.upload(renderer, pixels_.data(), cols_, rows_, SDL_SCALEMODE_LINEAR)) return;
+        texture_.draw(renderer, { 0.f, 0.f, (float)(cols_ * cellPixels_), (float)(rows_ * cellPixels_) });
+    }
+
+    int cols() const { return cols_; }
+    int rows() const { return rows_; }
+
+    // Particles of one layer in a cell, after accumulate()
+    Uint32 count(int layer, int col, int row) const {
+        return counts_[(size_t)cols_ * rows_ * layer + (size_t)row * cols_ + col];
+    }
+
+private:
+    std::vector<Uint32> counts_;   // [layer][row][col]
+    std::vector<Uint32> totals_;   // all layers, per cell
+    std::vector<Uint32> pixels_;
+    int cols_ = 0, rows_ = 0;
+    int cellPixels_ = 1;
+    int layerCount_ = 0;
+
+    StreamingTexture texture_;
+
+    static Uint32 pack(Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
+        const Uint8 bytes[4] = { r, g, b, a };
+        Uint32 c;
+        std::memcpy(&c, bytes, sizeof(c));
+        return c;
+    }
+
+    // log1p(n) for the small counts that make up most occupied cells
+    static const std::vector<float>& LogTable() {
+        static const std::vector<float> table = [] {
+            std::vector<float> t(1024);
+            for (int n = 0; n < 1024; ++n) t[n] = std::log1p((float)n);
+            return t;
+        }();
+        return table;
+    }
+
+    // 256-entry ramp interpolated between five inferno stops
+    static const std::vector<Uint32>& HeatRamp() {
+        static const std::vector<Uint32> ramp = [] {
+            const float stops[5][3] = {
+                {  40,  11,  84 }, { 101,  21, 110 }, { 188,  55,  84 },
+                { 249, 142,   9 }, { 252, 255, 164 },
+            };
+            std::vector<Uint32> r(256);
+            for (int i = 0; i < 256; ++i) {
+                const float t = i / 255.f * 4.f;
+                const int   s = std::min(3, (int)t);
+                const float f = t - s;
+                r[i] = pack((Uint8)(stops[s][0] + f * (stops[s + 1][0] - stops[s][0])),
+                            (Uint8)(stops[s][1] + f * (stops[s + 1][1] - stops[s][1])),
+                            (Uint8)(stops[s][2] + f * (stops[s + 1][2] - stops[s][2])), 255);
+            }
+            return r;
+        }();
+        return ramp;
+    }
+};
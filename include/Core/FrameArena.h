@@ -0,0 +1,156 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+/**
+ * Linear (bump) allocator for scratch data that lives for one frame.
+ *
+ * allocate() hands out aligned slices of a block; nothing is freed
+ * individually. reset() rewinds to the start. If a frame overflowed into
+ * extra blocks, reset() replaces them with a single block large enough for
+ * the whole frame, so a steady workload stops touching the heap after the
+ * first few frames.
+ *
+ * Every thread (main, OpenMP workers) gets its own arena through Local();
+ * ResetAll() rewinds all of them and is called by the main thread at the
+ * top of the frame, while no parallel region is running. Anything allocated
+ * from an arena must not be used after the next reset.
+ */
+class FrameArena {
+public:
+    static constexpr size_t DefaultBlockSize = 256 * 1024;
+
+    explicit FrameArena(size_t blockSize = DefaultBlockSize) : blockSize_(blockSize) {
+        addBlock(blockSize_);
+    }
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* allocate(size_t bytes, size_t align = alignof(std::max_align_t)) {
+        Block& b = blocks_.back();
+        uintptr_t base = reinterpret_cast<uintptr_t>(b.data.get());
+        size_t    at   = alignUp(base + b.offset, align) - base;
+        if (at + bytes > b.size) {
+            addBlock(std::max(blockSize_, bytes + align));
+            return allocate(bytes, align);
+        }
+        b.offset = at + bytes;
+        used_   += bytes;
+        highWater_ = std::max(highWater_, used_);
+        return b.data.get() + at;
+    }
+
+    template<typename T>
+    T* allocArray(size_t count) {
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void reset() {
+        if (blocks_.size() > 1) {
+            size_t total = 0;
+            for (const Block& b : blocks_) total += b.size;
+            blocks_.clear();
+            addBlock(total);
+        }
+        blocks_.back().offset = 0;
+        used_ = 0;
+    }
+
+    size_t used()      const { return used_;      }
+    size_t highWater() const { return highWater_; }
+    size_t capacity()  const {
+        size_t total = 0;
+        for (const Block& b : blocks_) total += b.size;
+        return total;
+    }
+
+    // ── Per-thread arenas ─────────────────────────────────────────────────
+    // The calling thread's arena, created on first use
+    static FrameArena& Local() {
+        thread_local FrameArena* local = nullptr;
+        if (!local) {
+            std::lock_guard<std::mutex> lock(registryMutex_);
+            registry_.push_back(std::make_unique<FrameArena>());
+            local = registry_.back().get();
+        }
+        return *local;
+    }
+
+    // Main thread, top of the frame
+    static void ResetAll() {
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        for (auto& arena : registry_) arena->reset();
+    }
+
+    struct Stats {
+        int    arenas    = 0;
+        size_t used      = 0;
+        size_t highWater = 0;   // sum of per-arena high-water marks
+        size_t capacity  = 0;
+    };
+
+    static Stats GetStats() {
+        std::lock_guard<std::mutex> lock(registryMutex_);
+        Stats s;
+        for (const auto& arena : registry_) {
+            ++s.arenas;
+            s.used      += arena->used();
+            s.highWater += arena->highWater();
+            s.capacity  += arena->capacity();
+        }
+        return s;
+    }
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        size_t size   = 0;
+        size_t offset = 0;
+    };
+
+    std::vector<Block> blocks_;
+    size_t blockSize_;
+    size_t used_      = 0;
+    size_t highWater_ = 0;
+
+    void addBlock(size_t size) {
+        blocks_.push_back({ std::make_unique<std::byte[]>(size), size, 0 });
+    }
+
+    static uintptr_t alignUp(uintptr_t p, size_t align) {
+        return (p + align - 1) & ~(uintptr_t)(align - 1);
+    }
+
+    static inline std::mutex                               registryMutex_;
+    static inline std::vector<std::unique_ptr<FrameArena>> registry_;
+};
+
+// std allocator over a FrameArena: allocate() bumps, deallocate() is a no-op.
+template<typename T>
+struct ArenaAllocator {
+    using value_type = T;
+
+    FrameArena* arena;
+
+    ArenaAllocator(FrameArena& a) noexcept : arena(&a) {}
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena(other.arena) {}
+
+    T*   allocate(size_t n)        { return arena->allocArray<T>(n); }
+    void deallocate(T*, size_t) noexcept {}
+
+    template<typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept { return arena == other.arena; }
+    template<typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const noexcept { return arena != other.arena; }
+};
+
+// Scratch vector for the current frame: FrameVector<int> v(FrameArena::Local());
+template<typename T>
+using FrameVector = std::vector<T, ArenaAllocator<T>>;
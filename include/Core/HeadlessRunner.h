@@ -0,0 +1,22 @@
+#pragma once
+
+#include <string>
+
+// Settings for a headless run: no window, no renderer, no ImGui.
+struct HeadlessConfig {
+    std::string simulation = "particlelife";   // particlelife | boids | knn
+    std::string presetPath;                    // empty = built-in default scene
+    int   frames      = 1000;
+    int   warmup      = 10;                    // untimed steps before measuring
+    int   worldWidth  = 1920;
+    int   worldHeight = 1080;
+    int   count       = 0;                     // overrides the preset / default count
+                                               // (per cluster for particlelife)
+    float deltaTime   = 1.0f / 60.0f;          // boids / knn fixed timestep
+};
+
+// Builds the requested system directly (optionally from a preset JSON),
+// steps it `frames` times as fast as possible and prints steps/s,
+// particle-updates/s and the average per-stage timings to stdout.
+// Returns a process exit code.
+int RunHeadless(const HeadlessConfig& config);
@@ -11,6 +11,8 @@ private:
     static Eigen::Vector2i mousePosition;
     static Eigen::Vector2i mouseDelta;
     static Eigen::Vector2i lastMousePosition;
+    static float mouseWheel;
+    static float mouseWheelAccum;
     
 public:
     // Initialize input system
@@ -37,4 +39,7 @@ public:
     static Eigen::Vector2i GetMouseDelta() { return mouseDelta; }
     static float GetMouseX() { return static_cast<float>(mousePosition.x()); }
     static float GetMouseY() { return static_cast<float>(mousePosition.y()); }
+
+    // Vertical wheel scroll accumulated over the last frame (positive = away from user)
+    static float GetMouseWheel() { return mouseWheel; }
 };
\ No newline at end of file
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+ * Line segments drawn as thin quads through SDL_RenderGeometry.
+ *
+ * Segments are appended to one buffer per OpenMP thread, so edge generation
+ * can run inside a parallel loop without locking: add(Thread(), ...).
+ * flush() submits each non-empty buffer with one SDL_RenderGeometry call,
+ * in thread order (with schedule(static) that is the serial order). Colour
+ * is per vertex, so each end of a segment can have its own alpha.
+ *
+ * Untextured geometry uses the renderer's draw blend mode; set
+ * SDL_BLENDMODE_BLEND for translucent lines.
+ */
+class LineBatch {
+public:
+    // Resets every buffer; call outside parallel regions
+    void clear() {
+        int threads = 1;
+#ifdef _OPENMP
+        threads = omp_get_max_threads();
+#endif
+        if ((int)buffers_.size() < threads) buffers_.resize(threads);
+        for (auto& b : buffers_) b.clear();
+    }
+
+    static int Thread() {
+#ifdef _OPENMP
+        return omp_get_thread_num();
+#else
+        return 0;
+#endif
+    }
+
+    void add(int thread, float x1, float y1, float x2, float y2,
+             const SDL_FColor& c1, const SDL_FColor& c2, float width = 1.f)
+    {
+        auto& v = buffers_[thread];
+        v.resize(v.size() + 4);
+        if (!Quad(&v[v.size() - 4], x1, y1, x2, y2, c1, c2, width)) v.resize(v.size() - 4);
+    }
+
+    void add(int thread, float x1, float y1, float x2, float y2,
+             const SDL_FColor& c, float width = 1.f)
+    {
+        add(thread, x1, y1, x2, y2, c, c, width);
+    }
+
+    // Writes the four corners of a segment quad (indices 0,1,2, 2,3,0) to
+    // out. A zero-length segment gets a degenerate quad and returns false.
+    static bool Quad(SDL_Vertex* out, float x1, float y1, float x2, float y2,
+                     const SDL_FColor& c1, const SDL_FColor& c2, float width = 1.f)
+    {
+        float nx = y1 - y2, ny = x2 - x1;              // normal
+        const float len2 = nx * nx + ny * ny;
+        const float s    = len2 > 0.f ? 0.5f * width / std::sqrt(len2) : 0.f;
+        nx *= s;
+        ny *= s;
+        out[0] = { { x1 + nx, y1 + ny }, c1, { 0.f, 0.f } };
+        out[1] = { { x2 + nx, y2 + ny }, c2, { 0.f, 0.f } };
+        out[2] = { { x2 - nx, y2 - ny }, c2, { 0.f, 0.f } };
+        out[3] = { { x1 - nx, y1 - ny }, c1, { 0.f, 0.f } };
+        return len2 > 0.f;
+    }
+
+    int size() const {
+        size_t vertices = 0;
+        for (const auto& b : buffers_) vertices += b.size();
+        return (int)(vertices / 4);
+    }
+
+    void flush(SDL_Renderer* renderer) {
+        size_t largest = 0;
+        for (const auto& b : buffers_) largest = std::max(largest, b.size() / 4);
+        for (size_t q = indices_.size() / 6; q < largest; ++q) {
+            const int v = (int)q * 4;
+            indices_.insert(indices_.end(), { v, v + 1, v + 2, v + 2, v + 3, v });
+        }
+
+        for (const auto& b : buffers_) {
+            if (b.empty()) continue;
+            const int quads = (int)(b.size() / 4);
+            SDL_RenderGeometry(renderer, nullptr, b.data(), quads * 4,
+                               indices_.data(), quads * 6);
+        }
+    }
+
+private:
+    std::vector<std::vector<SDL_Vertex>> buffers_;
+    std::vector<int>                     indices_;
+};
@@ -0,0 +1,189 @@
+#pragma once
+
+#include "Core/Camera2D.h"
+#include "Core/Profiler.h"
+#include "Core/StreamingTexture.h"
+#include <SDL3/SDL.h>
+#include <vector>
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+ * Software particle renderer for very large counts.
+ *
+ * rasterize() draws filled circles straight into a CPU pixel buffer in two
+ * parallel passes:
+ *   1. bin   - each thread projects a contiguous slice of the particles and
+ *              appends them to its own list per horizontal band of BandRows
+ *              rows (a circle crossing a band edge goes into both bands);
+ *   2. splat - each band is a tile owned by one thread, which clears it and
+ *              rasterises every thread's entries for that band in thread
+ *              order, so the paint order matches a serial pass.
+ * Bands never overlap, so threads write disjoint rows and no merge step is
+ * needed. present() uploads the buffer with one SDL_UpdateTexture and draws
+ * it as one quad, which costs the same on the software renderer as on a GPU.
+ *
+ * Circles use the same scanline mask and radius rules as CircleBatch.
+ */
+class ParticleSplatter {
+public:
+    static constexpr int BandRows = 32;
+
+    // One run of particles drawn in a single colour; later layers paint over
+    // earlier ones.
+    struct Layer {
+        const float* x;
+        const float* y;
+        int          count;
+        Uint8        r, g, b, a;
+    };
+
+    // radius is in screen pixels; the buffer is the camera's viewport size
+    void rasterize(const Layer* layers, int layerCount, int radius, const Camera2D& cam) {
+        width_  = std::max(1, (int)cam.viewW);
+        height_ = std::max(1, (int)cam.viewH);
+        pixels_.resize((size_t)width_ * height_);
+        ensureScanlines(radius <= 1 ? 0 : radius);
+
+        int total = 0;
+        for (int l = 0; l < layerCount; ++l) total += layers[l].count;
+
+        const int bandCount = (height_ + BandRows - 1) / BandRows;
+        int threadCount = 1;
+#ifdef _OPENMP
+        threadCount = omp_get_max_threads();
+#endif
+        if ((int)bins_.size() < threadCount * bandCount)
+            bins_.resize(threadCount * bandCount);
+        bandCount_ = bandCount;
+
+        {
+            PROFILE_ZONE("Splat bin");
+            #pragma omp parallel
+            {
+                int t = 0, nt = 1;
+#ifdef _OPENMP
+                t  = omp_get_thread_num();
+                nt = omp_get_num_threads();
+#endif
+                #pragma omp single
+                usedThreads_ = nt;
+
+                binSlice(layers, layerCount, cam, t,
+                         (int)((long long)total * t / nt),
+                         (int)((long long)total * (t + 1) / nt));
+            }
+        }
+
+        {
+            PROFILE_ZONE("Splat raster");
+            #pragma omp parallel for schedule(dynamic, 1)
+            for (int band = 0; band < bandCount; ++band)
+                splatBand(band);
+        }
+    }
+
+    // Uploads the last rasterised frame and draws it over the whole viewport
+    void present(SDL_Renderer* renderer) {
+        if (pixels_.empty()) return;
+        PROFILE_ZONE("Splat upload");
+
+        if (!texture_.upload(renderer, pixels_.data(), width_, height_)) return;
+        texture_.draw(renderer, { 0.f, 0.f, (float)width_, (float)height_ });
+    }
+
+    // RGBA32 (R, G, B, A byte order); transparent where nothing was drawn
+    const std::vector<Uint32>& pixels() const { return pixels_; }
+    int width()  const { return width_;  }
+    int height() const { return height_; }
+
+private:
+    struct Entry {
+        int    x, y;
+        Uint32 color;
+    };
+
+    std::vector<Uint32>             pixels_;
+    std::vector<std::vector<Entry>> bins_;   // [thread * bandCount_ + band]
+    std::vector<int>                scanlines_;
+    int width_ = 0, height_ = 0;
+    int radius_      = -1;
+    int bandCount_   = 0;
+    int usedThreads_ = 1;
+
+    StreamingTexture texture_;
+
+    // Scanline half-widths indexed by dy + radius
+    void ensureScanlines(int radius) {
+        if (radius == radius_) return;
+        radius_ = radius;
+        scanlines_.resize(2 * radius + 1);
+        for (int dy = -radius; dy <= radius; ++dy)
+            scanlines_[dy + radius] = (int)sqrtf((float)(radius * radius - dy * dy));
+    }
+
+    static Uint32 pack(Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
+        const Uint8 bytes[4] = { r, g, b, a };
+        Uint32 c;
+        std::memcpy(&c, bytes, sizeof(c));
+        return c;
+    }
+
+    // Global particle range [begin, end) across the layers, in layer order
+    void binSlice(const Layer* layers, int layerCount, const Camera2D& cam,
+                  int thread, int begin, int end)
+    {
+        std::vector<Entry>* bins = &bins_[(size_t)thread * bandCount_];
+        for (int b = 0; b < bandCount_; ++b) bins[b].clear();
+
+        const int r = radius_;
+        int base = 0;
+        for (int l = 0; l < layerCount && base < end; ++l) {
+            const Layer& layer = layers[l];
+            const int lo = std::max(begin, base) - base;
+            const int hi = std::min(end, base + layer.count) - base;
+            base += layer.count;
+            if (lo >= hi) continue;
+
+            const Uint32 color = pack(layer.r, layer.g, layer.b, layer.a);
+            for (int i = lo; i < hi; ++i) {
+                const int sx = (int)cam.worldToScreenX(layer.x[i]);
+                const int sy = (int)cam.worldToScreenY(layer.y[i]);
+                if (sx + r < 0 || sx - r >= width_ || sy + r < 0 || sy - r >= height_)
+                    continue;
+                const int b0 = std::max(sy - r, 0) / BandRows;
+                const int b1 = std::min(sy + r, height_ - 1) / BandRows;
+                for (int b = b0; b <= b1; ++b)
+                    bins[b].push_back({ sx, sy, color });
+            }
+        }
+    }
+
+    void splatBand(int band) {
+        const int row0 = band * BandRows;
+        const int row1 = std::min(row0 + BandRows, height_);
+        std::fill(pixels_.begin() + (size_t)row0 * width_,
+                  pixels_.begin() + (size_t)row1 * width_, 0u);
+
+        const int r = radius_;
+        for (int t = 0; t < usedThreads_; ++t) {
+            for (const Entry& e : bins_[(size_t)t * bandCount_ + band]) {
+                const int y0 = std::max(e.y - r, row0);
+                const int y1 = std::min(e.y + r, row1 - 1);
+                for (int y = y0; y <= y1; ++y) {
+                    const int half = scanlines_[y - e.y + r];
+                    const int x0 = std::max(e.x - half, 0);
+                    const int x1 = std::min(e.x + half, width_ - 1);
+                    if (x0 > x1) continue;
+                    Uint32* row = &pixels_[(size_t)y * width_];
+                    std::fill(row + x0, row + x1 + 1, e.color);
+                }
+            }
+        }
+    }
+};
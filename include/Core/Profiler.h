@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Compile-time switch (CMake option ENABLE_PROFILER). When 0, PROFILE_ZONE
+// expands to nothing and the hot paths carry no profiler code at all.
+#ifndef ALIFE_PROFILER
+#define ALIFE_PROFILER 1
+#endif
+
+/**
+ * Lightweight scoped-zone profiler.
+ *
+ * Each thread that records a zone gets its own lock-free single-producer ring
+ * buffer of events with steady_clock nanosecond timestamps, so zones inside
+ * OpenMP workers or the recorder thread never contend with the main thread.
+ * Once per frame the main thread drains every buffer (EndFrame), keeps the
+ * frame's events for the timeline view and appends each zone's frame total to
+ * a short history used for the stacked plot and the percentile table.
+ *
+ * While a trace is being captured every drained event is also kept and, on
+ * StopTrace(), written as Chrome Trace Event JSON (chrome://tracing,
+ * ui.perfetto.dev) with one track per thread.
+ *
+ * When disabled at runtime a zone costs one relaxed atomic load.
+ */
+class Profiler {
+public:
+    struct Event {
+        const char* name;      // must outlive the profiler (string literal)
+        uint64_t    startNs;
+        uint64_t    endNs;
+        uint32_t    threadId;
+        uint32_t    depth;     // nesting level on its thread, 0 = outermost
+    };
+
+    static bool IsEnabled() { return enabled_.load(std::memory_order_relaxed); }
+    static void SetEnabled(bool enabled);
+
+    // Nanoseconds on the steady clock since the profiler's epoch
+    static uint64_t NowNs();
+
+    // Optional label for the calling thread in the timeline ("main", ...).
+    // Cheap and allocation-free until the thread records a zone.
+    static void SetThreadName(const char* name);
+
+    // Zone bookkeeping, used by ProfileZone
+    static uint32_t BeginZone();
+    static void     EndZone(const char* name, uint64_t startNs);
+
+    // Main thread, once per frame: drains all thread buffers
+    static void EndFrame();
+
+    // Trace capture (F10). StartTrace enables the profiler for its duration;
+    // StopTrace writes capture/trace_<timestamp>.json and returns its path
+    // (empty on failure).
+    static void        StartTrace();
+    static std::string StopTrace();
+    static bool        IsTracing();
+
+    // ImPlot / ImDrawList panel: stacked per-frame timings, percentiles, timeline
+    static void DrawPanel(bool* open = nullptr);
+
+private:
+    static inline std::atomic<bool> enabled_{ false };
+};
+
+// RAII zone: records [construction, destruction) on the current thread.
+class ProfileZone {
+private:
+    const char* name_;
+    uint64_t    start_  = 0;
+    bool        active_;
+
+public:
+    explicit ProfileZone(const char* name)
+        : name_(name), active_(Profiler::IsEnabled())
+    {
+        if (active_) {
+            Profiler::BeginZone();
+            start_ = Profiler::NowNs();
+        }
+    }
+
+    ~ProfileZone() {
+        if (active_) Profiler::EndZone(name_, start_);
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+};
+
+#define ALIFE_PROFILE_CONCAT_(a, b) a##b
+#define ALIFE_PROFILE_CONCAT(a, b)  ALIFE_PROFILE_CONCAT_(a, b)
+
+#if ALIFE_PROFILER
+#define PROFILE_ZONE(name) ProfileZone ALIFE_PROFILE_CONCAT(profileZone_, __LINE__)(name)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#endif
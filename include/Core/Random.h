@@ -0,0 +1,26 @@
+#pragma once
+
+#include <random>
+#include <cstdint>
+
+// Process-wide random engine shared by all simulations.
+// Seeded from std::random_device unless Seed() is called (e.g. --seed on the
+// command line), which makes initial conditions and random rules reproducible.
+// Not thread-safe: only draw from it on the main thread.
+class Random {
+private:
+    static inline std::mt19937 engine_{std::random_device{}()};
+    static inline uint32_t     seed_   = 0;
+    static inline bool         seeded_ = false;
+
+public:
+    static void Seed(uint32_t seed) {
+        engine_.seed(seed);
+        seed_   = seed;
+        seeded_ = true;
+    }
+
+    static std::mt19937& Engine()   { return engine_; }
+    static bool          IsSeeded() { return seeded_; }
+    static uint32_t      GetSeed()  { return seed_;   }
+};
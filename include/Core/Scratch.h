@@ -0,0 +1,24 @@
+#pragma once
+
+/**
+ * Member wrapper for per-instance scratch: render batches, rasteriser bins,
+ * solver buffers and anything else rebuilt before every use.
+ *
+ * Copying the owner does not copy the scratch: copies start empty, and
+ * assignment keeps the target's own buffers (and their capacity). A system
+ * copied every frame, such as a snapshot published to the render thread,
+ * then only moves its real state. Same idea as StreamingTexture's copies.
+ *
+ * Scratch that indexes the owner's state (a spatial grid over its
+ * positions) provides invalidate(), which assignment calls because the
+ * state it indexed has just been replaced.
+ */
+template <class T>
+struct Scratch : T {
+    Scratch() = default;
+    Scratch(const Scratch&) : T() {}
+    Scratch& operator=(const Scratch&) {
+        if constexpr (requires(T& t) { t.invalidate(); }) T::invalidate();
+        return *this;
+    }
+};
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "Core/Profiler.h"
+#include <SDL3/SDL.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+ * Worker thread that runs one job at a time, in lockstep with the frame.
+ *
+ * run() hands a job over and returns at once; wait() blocks until it has
+ * finished. Anything the job touches belongs to the worker between the two
+ * calls, so the caller reads results and makes edits only after wait() and
+ * before the next run(). The usual frame is:
+ *   OnUpdate: wait(), take the published snapshot, apply input and edits
+ *   OnRender: run(next step + publish), then draw the snapshot
+ * so the step overlaps drawing, capture, GUI submission and present.
+ *
+ * While a job is in flight the caller's OpenMP thread budget is split
+ * between the two threads: the job's teams get three quarters of it, and
+ * the caller's own teams (render passes) are capped to the rest until
+ * wait() restores the budget. Both sides then share the cores instead of
+ * each asking for all of them. Jobs must not use FrameArena: the main
+ * thread rewinds every arena at the top of each frame, possibly while a
+ * job is in flight.
+ */
+class SimulationThread {
+public:
+    SimulationThread() = default;
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+
+    ~SimulationThread() {
+        if (!thread_.joinable()) return;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_one();
+        thread_.join();
+    }
+
+    // Starts job on the worker; waits for the previous one first
+    void run(std::function<void()> job) {
+        wait();
+        if (!thread_.joinable())
+            thread_ = std::thread([this] { loop(); });
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            job_  = std::move(job);
+            busy_ = true;
+#ifdef _OPENMP
+            budget_     = omp_get_max_threads();
+            jobThreads_ = std::max(1, budget_ - std::max(1, budget_ / 4));
+            omp_set_num_threads(std::max(1, budget_ - jobThreads_));
+#endif
+        }
+        wake_.notify_one();
+    }
+
+    void wait() {
+        const Uint64 start = SDL_GetPerformanceCounter();
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            done_.wait(lock, [this] { return !busy_; });
+        }
+        waitMs_ = (double)(SDL_GetPerformanceCounter() - start) * 1000.0
+                / (double)SDL_GetPerformanceFrequency();
+#ifdef _OPENMP
+        if (budget_ > 0) omp_set_num_threads(budget_);
+        budget_ = 0;
+#endif
+    }
+
+    // OpenMP threads of the last job's teams (1 without OpenMP)
+    int getJobThreads() const { return jobThreads_; }
+
+    // Wall time of the last finished job, and how long the last wait() blocked
+    double getLastJobMs()  const { return jobMs_;  }
+    double getLastWaitMs() const { return waitMs_; }
+
+private:
+    std::thread             thread_;
+    std::mutex              mutex_;
+    std::condition_variable wake_, done_;
+    std::function<void()>   job_;
+    bool   busy_   = false;
+    bool   stop_   = false;
+    double jobMs_  = 0.0;   // written by the worker before busy_ clears
+    double waitMs_ = 0.0;
+    int    budget_     = 0; // caller's thread count while capped, 0 = not capped
+    int    jobThreads_ = 1;
+
+    void loop() {
+        Profiler::SetThreadName("simulation");
+        for (;;) {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [this] { return stop_ || (busy_ && job_); });
+                if (stop_) return;
+                job = std::move(job_);
+                job_ = nullptr;
+            }
+#ifdef _OPENMP
+            omp_set_num_threads(jobThreads_);   // set by run() before the wake-up
+#endif
+
+            const Uint64 start = SDL_GetPerformanceCounter();
+            job();
+            const double ms = (double)(SDL_GetPerformanceCounter() - start) * 1000.0
+                            / (double)SDL_GetPerformanceFrequency();
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                jobMs_ = ms;
+                busy_  = false;
+            }
+            done_.notify_all();
+        }
+    }
+};
@@ -3,17 +3,39 @@
 #include <vector>
 #include <algorithm>
 
+#include "Core/Profiler.h"
+
 // Uniform-cell spatial hash grid for fast neighbor queries.
 // Build once per frame with build(), then query with forEachNeighbor().
 // Designed for 2D float positions; cell size must be >= query radius.
 struct SpatialGrid {
     std::vector<int> count, start, idx, fill;
 
+    // Layout of the last build() — lets other passes (e.g. render culling)
+    // query the grid without knowing how it was built.
+    float layoutCellSize = 1.f;
+    float layoutOffX     = 0.f;
+    float layoutOffY     = 0.f;
+    int   layoutCols     = 0;
+    int   layoutRows     = 0;
+
+    // Marks the grid as not matching any positions (forEachInRect() then
+    // visits nothing, and layoutCols == 0 tells callers to rebuild); keeps
+    // the buffers' capacity
+    void invalidate() { layoutCols = layoutRows = 0; }
+
     // offX/offY shift the coordinate origin (use marginX/marginY for wrapped worlds).
     void build(const float* px, const float* py, int n,
                float cellSize, int cols, int rows,
                float offX = 0.f, float offY = 0.f)
     {
+        PROFILE_ZONE("Grid build");
+        layoutCellSize = cellSize;
+        layoutOffX     = offX;
+        layoutOffY     = offY;
+        layoutCols     = cols;
+        layoutRows     = rows;
+
         const int cells = cols * rows;
         count.assign(cells, 0);
         fill.assign(cells, 0);
@@ -57,18 +79,123 @@ struct SpatialGrid {
     }
 
     // 3x3 neighborhood with toroidal wrapping — for worlds with wrapped boundaries.
+    // Axes with fewer than 3 cells are visited once per distinct cell.
     template<typename Func>
     void forEachNeighborWrapped(int cx0, int cy0, int cols, int rows,
                                 const Func& func) const
     {
-        for (int dy = -1; dy <= 1; ++dy) {
-            const int ny = ((cy0 + dy) % rows + rows) % rows;
-            for (int dx = -1; dx <= 1; ++dx) {
-                const int nx = ((cx0 + dx) % cols + cols) % cols;
+        const int ry = std::min(rows, 3), rx = std::min(cols, 3);
+        for (int dy = 0; dy < ry; ++dy) {
+            const int ny = ((cy0 + dy - 1) % rows + rows) % rows;
+            for (int dx = 0; dx < rx; ++dx) {
+                const int nx = ((cx0 + dx - 1) % cols + cols) % cols;
                 const int cell = ny * cols + nx;
                 for (int k = start[cell], end = start[cell + 1]; k < end; ++k)
                     func(idx[k]);
             }
         }
     }
+
+    // Every point whose cell overlaps the rectangle [x0,x1] x [y0,y1], using the
+    // layout of the last build().  Candidates near the border still need an
+    // exact test by the caller.
+    template<typename Func>
+    void forEachInRect(float x0, float y0, float x1, float y1,
+                       const Func& func) const
+    {
+        if (layoutCols == 0 || layoutRows == 0) return;
+        const float cs  = layoutCellSize;
+        const int   cx0 = std::clamp((int)((x0 - layoutOffX) / cs), 0, layoutCols - 1);
+        const int   cx1 = std::clamp((int)((x1 - layoutOffX) / cs), 0, layoutCols - 1);
+        const int   cy0 = std::clamp((int)((y0 - layoutOffY) / cs), 0, layoutRows - 1);
+        const int   cy1 = std::clamp((int)((y1 - layoutOffY) / cs), 0, layoutRows - 1);
+        for (int gy = cy0; gy <= cy1; ++gy) {
+            for (int gx = cx0; gx <= cx1; ++gx) {
+                const int cell = gy * layoutCols + gx;
+                for (int k = start[cell], end = start[cell + 1]; k < end; ++k)
+                    func(idx[k]);
+            }
+        }
+    }
+};
+
+// 3D counterpart of SpatialGrid — same counting-sort layout, 27-cell stencil.
+// Cell size must be >= query radius.
+struct SpatialGrid3D {
+    std::vector<int> count, start, idx, fill;
+
+    int cols = 0, rows = 0, layers = 0;
+
+    int cellOf(float x, float y, float z, float cellSize,
+               float offX, float offY, float offZ) const
+    {
+        const int cx = std::clamp((int)((x - offX) / cellSize), 0, cols   - 1);
+        const int cy = std::clamp((int)((y - offY) / cellSize), 0, rows   - 1);
+        const int cz = std::clamp((int)((z - offZ) / cellSize), 0, layers - 1);
+        return (cz * rows + cy) * cols + cx;
+    }
+
+    void build(const float* px, const float* py, const float* pz, int n,
+               float cellSize, int cols_, int rows_, int layers_,
+               float offX = 0.f, float offY = 0.f, float offZ = 0.f)
+    {
+        PROFILE_ZONE("Grid build 3D");
+        cols = cols_; rows = rows_; layers = layers_;
+        const int cells = cols * rows * layers;
+        count.assign(cells, 0);
+        fill.assign(cells, 0);
+        start.resize(cells + 1);
+        idx.resize(n);
+
+        for (int j = 0; j < n; ++j)
+            ++count[cellOf(px[j], py[j], pz[j], cellSize, offX, offY, offZ)];
+
+        start[0] = 0;
+        for (int i = 0; i < cells; ++i)
+            start[i + 1] = start[i] + count[i];
+
+        for (int j = 0; j < n; ++j) {
+            const int cell = cellOf(px[j], py[j], pz[j], cellSize, offX, offY, offZ);
+            idx[start[cell] + fill[cell]++] = j;
+        }
+    }
+
+    // 3x3x3 neighborhood — clamps at borders (non-wrapping worlds).
+    template<typename Func>
+    void forEachNeighbor(int cx0, int cy0, int cz0, const Func& func) const {
+        for (int dz = -1; dz <= 1; ++dz) {
+            const int nz = cz0 + dz;
+            if (nz < 0 || nz >= layers) continue;
+            for (int dy = -1; dy <= 1; ++dy) {
+                const int ny = cy0 + dy;
+                if (ny < 0 || ny >= rows) continue;
+                for (int dx = -1; dx <= 1; ++dx) {
+                    const int nx = cx0 + dx;
+                    if (nx < 0 || nx >= cols) continue;
+                    const int cell = (nz * rows + ny) * cols + nx;
+                    for (int k = start[cell], end = start[cell + 1]; k < end; ++k)
+                        func(idx[k]);
+                }
+            }
+        }
+    }
+
+    // 3x3x3 neighborhood with toroidal wrapping on all three axes.
+    // Axes with fewer than 3 cells are visited once per distinct cell.
+    template<typename Func>
+    void forEachNeighborWrapped(int cx0, int cy0, int cz0, const Func& func) const {
+        const int rz = std::min(layers, 3), ry = std::min(rows, 3), rx = std::min(cols, 3);
+        for (int dz = 0; dz < rz; ++dz) {
+            const int nz = ((cz0 + dz - 1) % layers + layers) % layers;
+            for (int dy = 0; dy < ry; ++dy) {
+                const int ny = ((cy0 + dy - 1) % rows + rows) % rows;
+                for (int dx = 0; dx < rx; ++dx) {
+                    const int nx = ((cx0 + dx - 1) % cols + cols) % cols;
+                    const int cell = (nz * rows + ny) * cols + nx;
+                    for (int k = start[cell], end = start[cell + 1]; k < end; ++k)
+                        func(idx[k]);
+                }
+            }
+        }
+    }
 };
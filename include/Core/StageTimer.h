@@ -0,0 +1,76 @@
+#pragma once
+
+#include <chrono>
+#include <array>
+#include <string>
+#include <vector>
+
+// Wall-clock durations of the stages of one update() call.
+// Systems fill it every update; runners and GUIs read it afterwards.
+struct StageTimings {
+    static constexpr int MaxStages = 8;
+
+    std::array<const char*, MaxStages> names{};
+    std::array<double, MaxStages>      ms{};
+    int count = 0;
+
+    void clear() { count = 0; }
+
+    void add(const char* name, double durationMs) {
+        if (count < MaxStages) {
+            names[count] = name;
+            ms[count]    = durationMs;
+            ++count;
+        }
+    }
+
+    double total() const {
+        double t = 0.0;
+        for (int i = 0; i < count; ++i) t += ms[i];
+        return t;
+    }
+};
+
+// Running sum of StageTimings over many updates, keyed by stage name in
+// first-seen order (optional stages such as "collisions" may come and go).
+struct StageTotals {
+    std::vector<std::string> names;
+    std::vector<double>      totalMs;
+    long long                samples = 0;
+
+    void add(const StageTimings& t) {
+        for (int i = 0; i < t.count; ++i) {
+            size_t k = 0;
+            while (k < names.size() && names[k] != t.names[i]) ++k;
+            if (k == names.size()) { names.emplace_back(t.names[i]); totalMs.push_back(0.0); }
+            totalMs[k] += t.ms[i];
+        }
+        ++samples;
+    }
+
+    double averageMs(size_t k) const {
+        return samples > 0 ? totalMs[k] / (double)samples : 0.0;
+    }
+
+    void clear() { names.clear(); totalMs.clear(); samples = 0; }
+};
+
+// Records consecutive stages: each lap() closes the stage started by the
+// previous lap() (or by construction).
+class StageClock {
+private:
+    using Clock = std::chrono::steady_clock;
+    StageTimings&     timings_;
+    Clock::time_point last_;
+
+public:
+    explicit StageClock(StageTimings& t) : timings_(t), last_(Clock::now()) {
+        timings_.clear();
+    }
+
+    void lap(const char* name) {
+        const auto now = Clock::now();
+        timings_.add(name, std::chrono::duration<double, std::milli>(now - last_).count());
+        last_ = now;
+    }
+};
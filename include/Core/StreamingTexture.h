@@ -0,0 +1,44 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+/**
+ * RGBA32 streaming texture refilled from a CPU buffer every frame.
+ *
+ * Recreated when the size or renderer changes. The renderer owns the
+ * texture and frees it in SDL_DestroyRenderer, so there is no destructor;
+ * copies start empty and create their own on first upload.
+ */
+class StreamingTexture {
+public:
+    StreamingTexture() = default;
+    StreamingTexture(const StreamingTexture&) {}
+    StreamingTexture& operator=(const StreamingTexture&) { return *this; }
+
+    // pixels: width * height RGBA32 values, rows packed
+    bool upload(SDL_Renderer* renderer, const void* pixels, int width, int height,
+                SDL_ScaleMode scaleMode = SDL_SCALEMODE_NEAREST)
+    {
+        if (!texture_ || renderer != owner_ || width != width_ || height != height_) {
+            if (texture_ && renderer == owner_) SDL_DestroyTexture(texture_);
+            texture_ = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32,
+                                         SDL_TEXTUREACCESS_STREAMING, width, height);
+            owner_  = renderer;
+            width_  = width;
+            height_ = height;
+            if (!texture_) return false;
+            SDL_SetTextureBlendMode(texture_, SDL_BLENDMODE_BLEND);
+        }
+        SDL_SetTextureScaleMode(texture_, scaleMode);
+        return SDL_UpdateTexture(texture_, nullptr, pixels, width * 4);
+    }
+
+    void draw(SDL_Renderer* renderer, const SDL_FRect& dst) const {
+        if (texture_) SDL_RenderTexture(renderer, texture_, nullptr, &dst);
+    }
+
+private:
+    SDL_Texture*  texture_ = nullptr;
+    SDL_Renderer* owner_   = nullptr;
+    int width_ = 0, height_ = 0;
+};
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "Core/LineBatch.h"
+#include <SDL3/SDL.h>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+/**
+ * Exact polyline trails for a subset of particles.
+ *
+ * Track t follows item t * count / tracks, so the tracks are spread evenly
+ * over the population. Each track keeps its last getLength() positions in a
+ * ring that record() advances once per simulation step. draw() emits every
+ * track as a polyline into a LineBatch, opaque at the newest point and
+ * fading out at the oldest.
+ *
+ * setTracks() and setLength() take effect at the next record(); until then
+ * draw() keeps reading the rings with the layout they were recorded with.
+ *
+ * Memory is tracks * length points whatever the particle count. Trails for
+ * the whole population come from the application's accumulation buffer
+ * (Application::SetTrails) instead.
+ */
+class TrailHistory {
+public:
+    int  getTracks() const { return tracks_; }
+    int  getLength() const { return length_; }
+    void setTracks(int n)  { tracks_ = std::max(0, n); }
+    void setLength(int n)  { length_ = std::max(2, n); }
+
+    // Drops the recorded points, e.g. when items are added or removed
+    void reset() { filled_ = 0; }
+
+    // Item index followed by a track, for the current count
+    int source(int track) const { return (int)((long long)track * count_ / active_); }
+
+    // position(index, x, y) reads the position of item index of count. The
+    // history restarts whenever count, the track count or the length changes.
+    template <class Position>
+    void record(int count, const Position& position) {
+        const int active = std::min(tracks_, std::max(0, count));
+        if (active != active_ || count != count_ || stride_ != length_) {
+            active_ = active;
+            count_  = count;
+            stride_ = length_;
+            points_.assign((size_t)active * stride_, { 0.f, 0.f });
+            filled_ = 0;
+        }
+        if (active_ == 0) return;
+
+        head_   = filled_ == 0 ? 0 : (head_ + 1) % stride_;
+        filled_ = std::min(filled_ + 1, stride_);
+        for (int t = 0; t < active_; ++t) {
+            Point& p = points_[(size_t)t * stride_ + head_];
+            position(source(t), p.x, p.y);
+        }
+    }
+
+    // project(x, y, sx, sy) maps a recorded position to the screen and
+    // colorOf(track) gives the newest segment's colour. Steps longer than
+    // maxJump on either axis (wrap-around teleports) are not drawn.
+    template <class Project, class ColorOf>
+    void draw(LineBatch& batch, const Project& project, const ColorOf& colorOf,
+              float maxJump, float width = 1.f) const
+    {
+        if (filled_ < 2) return;
+        const float fade = 1.f / (filled_ - 1);
+
+        #pragma omp parallel for schedule(static)
+        for (int t = 0; t < active_; ++t) {
+            const Point* ring  = &points_[(size_t)t * stride_];
+            const SDL_FColor c = colorOf(t);
+            const int thread   = LineBatch::Thread();
+
+            int   cur = head_;
+            float sx, sy;
+            project(ring[cur].x, ring[cur].y, sx, sy);
+            for (int k = 1; k < filled_; ++k) {
+                const int prev = cur == 0 ? stride_ - 1 : cur - 1;
+                float px, py;
+                project(ring[prev].x, ring[prev].y, px, py);
+
+                if (std::fabs(ring[cur].x - ring[prev].x) <= maxJump &&
+                    std::fabs(ring[cur].y - ring[prev].y) <= maxJump)
+                {
+                    SDL_FColor c1 = c, c2 = c;
+                    c1.a = c.a * (1.f - (k - 1) * fade);
+                    c2.a = c.a * (1.f - k * fade);
+                    batch.add(thread, sx, sy, px, py, c1, c2, width);
+                }
+                cur = prev;
+                sx  = px;
+                sy  = py;
+            }
+        }
+    }
+
+private:
+    struct Point { float x, y; };
+
+    std::vector<Point> points_;   // [track][slot], slot head_ is the newest
+    int tracks_ = 0;              // requested; 0 disables recording
+    int length_ = 64;             // requested
+    int stride_ = 0;              // ring length points_ was recorded with
+    int active_ = 0;              // min(tracks_, count_) at the last record()
+    int count_  = 0;
+    int head_   = 0;
+    int filled_ = 0;
+};
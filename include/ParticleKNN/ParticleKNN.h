@@ -4,6 +4,8 @@
 #include <vector>
 #include <random>
 
+#include "Core/Random.h"
+
 struct ParticleKNN {
     Eigen::Vector2f position;
     Eigen::Vector2f velocity;
@@ -19,7 +21,7 @@ struct ParticleKNN {
 
     void randomizeDirection() {
         static std::uniform_real_distribution<float> angle(0.0f, 2.0f * 3.14159265f);
-        float a = angle(rng_);
+        float a = angle(Random::Engine());
         targetVelocity = Eigen::Vector2f(std::cos(a), std::sin(a)) * speed;
     }
 
@@ -33,14 +35,9 @@ struct ParticleKNN {
         if (position.y() > screenHeight) position.y() = 0;
 
         static std::uniform_real_distribution<float> roll(0.0f, 1.0f);
-        if (roll(rng_) < 0.01f)
+        if (roll(Random::Engine()) < 0.01f)
             randomizeDirection();
     }
-
-private:
-    // Shared generator across all instances; avoids duplicated static RNGs
-    // in randomizeDirection() and update()
-    static inline std::mt19937 rng_{std::random_device{}()};
 };
 
 struct KNNParameters {
@@ -2,7 +2,18 @@
 
 #include "ParticleKNN/ParticleKNN.h"
 #include "Core/SpatialGrid.h"
+#include "Core/StageTimer.h"
+#include "Core/Random.h"
+#include "Core/Profiler.h"
+#include "Core/AllocTracker.h"
+#include "Core/FrameArena.h"
+#include "Core/CircleBatch.h"
+#include "Core/LineBatch.h"
+#include "Core/TrailHistory.h"
 #include <SDL3/SDL.h>
+#include <nlohmann/json.hpp>
+#include <fstream>
+#include <string>
 #include <random>
 #include <cmath>
 #include <algorithm>
@@ -17,40 +28,29 @@ private:
     std::vector<float> soaX_, soaY_;
     SpatialGrid        grid_;
 
-    // Scanline cache for filled-circle rendering (recomputed when size changes)
-    std::vector<int> circleScanlines_;
-    int              cachedCircleRadius_ = -1;
+    StageTimings timings_;
 
-    static std::random_device rd;
-    static std::mt19937       gen;
+    CircleBatch circles_;
+    LineBatch   lines_;
 
-    void rebuildCircleCache(int r) {
-        if (r == cachedCircleRadius_) return;
-        cachedCircleRadius_ = r;
-        circleScanlines_.resize(2 * r + 1);
-        for (int y = -r; y <= r; ++y)
-            circleScanlines_[y + r] = (int)std::sqrt((float)(r * r - y * y));
-    }
+    // Positions before the last update, and the interpolated ones drawn
+    std::vector<Eigen::Vector2f> previous_, drawn_;
+    float wrapJump_ = 540.0f;   // moves longer than this are wrap-arounds (half the screen)
 
-    void drawFilledCircle(SDL_Renderer* renderer, float cx, float cy, float radius) {
-        const int r = (int)radius;
-        rebuildCircleCache(r);
-        for (int y = -r; y <= r; ++y)
-            SDL_RenderLine(renderer,
-                           cx - circleScanlines_[y + r], cy + y,
-                           cx + circleScanlines_[y + r], cy + y);
-    }
+    // Polyline trails of a subset
+    TrailHistory trails_;
 
 public:
     ParticleKNNSystem() {
-        gen.seed(rd());
         params.updateSquared();
     }
 
     void generate(int count, int screenWidth, int screenHeight) {
         particles.clear();
+        previous_.clear();
         particles.reserve(count);
 
+        auto& gen = Random::Engine();
         std::uniform_real_distribution<float> posX(0.0f, (float)screenWidth);
         std::uniform_real_distribution<float> posY(0.0f, (float)screenHeight);
 
@@ -61,8 +61,25 @@ public:
     void update(float deltaTime, int screenWidth, int screenHeight) {
         const int n = (int)particles.size();
 
+        PROFILE_ZONE("KNN update");
+        ALLOC_SCOPE("KNN");
+        StageClock clock(timings_);
+
+        previous_.resize(n);
+        for (int i = 0; i < n; ++i) previous_[i] = particles[i].position;
+        wrapJump_ = 0.5f * (float)std::min(screenWidth, screenHeight);
+
         for (auto& p : particles)
             p.update(deltaTime, screenWidth, screenHeight);
+        clock.lap("integrate");
+
+        if (trails_.getTracks() > 0) {
+            trails_.record(n, [&](int i, float& x, float& y) {
+                x = particles[i].position.x();
+                y = particles[i].position.y();
+            });
+            clock.lap("trails");
+        }
 
         // Extract positions to SoA for grid
         soaX_.resize(n);
@@ -78,11 +95,13 @@ public:
         const int   cols = std::max(1, (int)((float)screenWidth  / cs) + 2);
         const int   rows = std::max(1, (int)((float)screenHeight / cs) + 2);
         grid_.build(soaX_.data(), soaY_.data(), n, cs, cols, rows);
+        clock.lap("grid");
 
         // Find K-nearest connections using the grid — O(n * avg_cell_pop)
         connections.clear();
 
-        std::vector<std::pair<float, int>> neighbors; // (distSq, index)
+        FrameVector<std::pair<float, int>> neighbors(FrameArena::Local()); // (distSq, index)
+        neighbors.reserve(64);
         for (int i = 0; i < n; ++i) {
             neighbors.clear();
 
@@ -109,31 +128,73 @@ public:
                 connections.push_back({i, neighbors[m].second,
                                        std::sqrt(neighbors[m].first)});
         }
+        clock.lap("knn");
     }
 
-    void draw(SDL_Renderer* renderer) {
-        // Connections first (lines with distance-based alpha)
-        for (const auto& conn : connections) {
-            const auto& p1 = particles[conn.particleA].position;
-            const auto& p2 = particles[conn.particleB].position;
-
-            const float alpha    = 1.0f - (conn.distance / params.maxDistance);
-            const Uint8 alphaVal = (Uint8)(alpha * 150.0f);
+    // interpolation: 0 draws the positions before the last update, 1 the current ones
+    void draw(SDL_Renderer* renderer, float interpolation = 1.0f) {
+        PROFILE_ZONE("Draw KNN");
+        const int n = (int)particles.size();
+        const bool blend = interpolation < 1.f && (int)previous_.size() == n;
+        drawn_.resize(n);
+        for (int i = 0; i < n; ++i) {
+            const Eigen::Vector2f& cur = particles[i].position;
+            const Eigen::Vector2f  d   = cur - (blend ? previous_[i] : cur);
+            drawn_[i] = blend && std::fabs(d.x()) < wrapJump_ && std::fabs(d.y()) < wrapJump_
+                      ? Eigen::Vector2f(previous_[i] + d * interpolation) : cur;
+        }
 
-            SDL_SetRenderDrawColor(renderer, 100, 150, 200, alphaVal);
-            SDL_RenderLine(renderer, p1.x(), p1.y(), p2.x(), p2.y());
+        // Connections first: distance-based alpha, generated in parallel
+        const int count = (int)connections.size();
+        lines_.clear();
+        #pragma omp parallel for schedule(static)
+        for (int c = 0; c < count; ++c) {
+            const auto& conn = connections[c];
+            const auto& p1   = drawn_[conn.particleA];
+            const auto& p2   = drawn_[conn.particleB];
+
+            const float alpha = 1.0f - (conn.distance / params.maxDistance);
+            const SDL_FColor col = { 100 / 255.f, 150 / 255.f, 200 / 255.f,
+                                     (float)(Uint8)(alpha * 150.0f) / 255.f };
+            lines_.add(LineBatch::Thread(), p1.x(), p1.y(), p2.x(), p2.y(), col);
         }
+        trails_.draw(lines_,
+            [](float x, float y, float& sx, float& sy) { sx = x; sy = y; },
+            [](int) { return SDL_FColor{ 1.f, 0.8f, 0.3f, 0.8f }; },
+            wrapJump_);
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+        lines_.flush(renderer);
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+
+        // Particles as filled circles, one batch
+        const SDL_FColor white = { 1.f, 1.f, 1.f, 1.f };
+        circles_.clear();
+        for (int i = 0; i < n; ++i)
+            circles_.add(drawn_[i].x(), drawn_[i].y(), (int)particles[i].size, white);
+        circles_.flush(renderer);
+    }
 
-        // Particles as filled circles
-        SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
-        for (const auto& p : particles)
-            drawFilledCircle(renderer, p.position.x(), p.position.y(), p.size);
+    // Reads parameters and the particle count from a preset JSON:
+    // { "count", "maxConnections", "maxDistance" }
+    // Missing keys keep their current value. Does not regenerate particles.
+    bool loadFromFile(const std::string& path, int& count) {
+        std::ifstream file(path);
+        if (!file.is_open()) return false;
+
+        nlohmann::json j;
+        try { file >> j; }
+        catch (const nlohmann::json::exception&) { return false; }
+
+        count = j.value("count", count);
+        params.maxConnections = j.value("maxConnections", params.maxConnections);
+        params.maxDistance    = j.value("maxDistance",    params.maxDistance);
+        params.updateSquared();
+        return true;
     }
 
     int            getCount()           const { return (int)particles.size(); }
     int            getConnectionCount() const { return (int)connections.size(); }
     KNNParameters& getParameters()            { return params; }
+    TrailHistory&  getTrailHistory()          { return trails_; }
+    const StageTimings& getStageTimings() const { return timings_; }
 };
-
-inline std::random_device ParticleKNNSystem::rd;
-inline std::mt19937       ParticleKNNSystem::gen(ParticleKNNSystem::rd());
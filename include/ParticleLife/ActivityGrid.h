@@ -0,0 +1,187 @@
+#pragma once
+
+#include "Cluster.h"
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+namespace ParticleLife {
+
+/**
+ * Per-cell activity tracking used to put equilibrated regions to sleep.
+ *
+ * The world is divided into cells of the largest interaction radius, so every
+ * particle that can act on a cell lives in its 3x3 neighborhood.  Each frame
+ * track() records how long every cell has stayed below the velocity
+ * threshold; a cell sleeps once it and all 8 neighbors have been still for
+ * `sleepFrames` frames.  Particles in sleeping cells get their Cluster::asleep
+ * flag set and are skipped by Cluster::rule() on the next update.  Any motion
+ * in a neighbor cell — or wake() from the mouse brush — resets the counters
+ * and wakes the region.
+ */
+class ActivityGrid {
+private:
+    std::vector<uint16_t> stillFrames_;   // frames each cell has been still
+    std::vector<float>    cellMaxV2_;     // scratch: max speed² in cell this frame
+    std::vector<uint8_t>  cellAsleep_;
+
+    // Cell index of every particle at the last track(), per cluster.
+    std::vector<std::vector<int>> particleCell_;
+
+    float cellSize_ = 0.f;
+    float offX_     = 0.f;
+    float offY_     = 0.f;
+    int   cols_     = 0;
+    int   rows_     = 0;
+    bool  wrapping_ = false;
+
+    int activeCells_ = 0;
+
+    int cellOf(float x, float y) const {
+        const int cx = std::clamp((int)((x - offX_) / cellSize_), 0, cols_ - 1);
+        const int cy = std::clamp((int)((y - offY_) / cellSize_), 0, rows_ - 1);
+        return cy * cols_ + cx;
+    }
+
+    // A cell sleeps when it and its 8 neighbors have all been still long enough.
+    void refreshCells(int sleepFrames) {
+        const int cells = cols_ * rows_;
+        cellAsleep_.assign(cells, 0);
+        activeCells_ = 0;
+        for (int cy = 0; cy < rows_; ++cy) {
+            for (int cx = 0; cx < cols_; ++cx) {
+                bool still = true;
+                for (int dy = -1; dy <= 1 && still; ++dy) {
+                    int ny = cy + dy;
+                    if (wrapping_)                 ny = (ny + rows_) % rows_;
+                    else if (ny < 0 || ny >= rows_) continue;
+                    for (int dx = -1; dx <= 1; ++dx) {
+                        int nx = cx + dx;
+                        if (wrapping_)                 nx = (nx + cols_) % cols_;
+                        else if (nx < 0 || nx >= cols_) continue;
+                        if (stillFrames_[ny * cols_ + nx] < sleepFrames) { still = false; break; }
+                    }
+                }
+                cellAsleep_[cy * cols_ + cx] = still ? 1 : 0;
+                if (!still) ++activeCells_;
+            }
+        }
+    }
+
+    void refreshParticles(std::vector<Cluster>& clusters) const {
+        for (int c = 0; c < (int)clusters.size(); ++c) {
+            Cluster& cl = clusters[c];
+            const int n = cl.size();
+            if (c >= (int)particleCell_.size() || (int)particleCell_[c].size() != n) {
+                cl.asleep.clear();
+                continue;
+            }
+            cl.asleep.resize(n);
+            for (int i = 0; i < n; ++i) {
+                const uint8_t s = cellAsleep_[particleCell_[c][i]];
+                cl.asleep[i] = s;
+                if (s) { cl.velX[i] = 0.f; cl.velY[i] = 0.f; }
+            }
+        }
+    }
+
+public:
+    int getActiveCells() const { return activeCells_; }
+    int getTotalCells()  const { return cols_ * rows_; }
+
+    // Sets the cell layout. A layout change (e.g. a rule radius edit) wakes everything.
+    void configure(float cellSize, float worldW, float worldH,
+                   bool wrapping, float marginX, float marginY)
+    {
+        cellSize = std::max(cellSize, 1.f);
+        int   cols, rows;
+        float offX = 0.f, offY = 0.f;
+        if (wrapping) {
+            // Rounded down like the rule grid: the clamp in cellOf() folds the
+            // remainder into the last cell, so no cell is narrower than the
+            // radius and seam neighbours stay in each other's 3x3 block.
+            cols = std::max(1, (int)((worldW - 2.f * marginX) / cellSize));
+            rows = std::max(1, (int)((worldH - 2.f * marginY) / cellSize));
+            offX = marginX;
+            offY = marginY;
+        } else {
+            cols = std::max(1, (int)(worldW / cellSize) + 2);
+            rows = std::max(1, (int)(worldH / cellSize) + 2);
+        }
+
+        if (cellSize == cellSize_ && cols == cols_ && rows == rows_ &&
+            offX == offX_ && offY == offY_ && wrapping == wrapping_)
+            return;
+
+        cellSize_ = cellSize;
+        cols_ = cols; rows_ = rows;
+        offX_ = offX; offY_ = offY;
+        wrapping_ = wrapping;
+        stillFrames_.assign(cols_ * rows_, 0);
+        cellAsleep_.assign(cols_ * rows_, 0);
+        activeCells_ = cols_ * rows_;
+    }
+
+    // Call after integration. Updates the stillness counters and the per-particle
+    // sleep flags used by the next update.
+    void track(std::vector<Cluster>& clusters, float sleepSpeed, int sleepFrames) {
+        const int cells = cols_ * rows_;
+        if (cells == 0) return;
+
+        cellMaxV2_.assign(cells, 0.f);
+        particleCell_.resize(clusters.size());
+
+        for (int c = 0; c < (int)clusters.size(); ++c) {
+            const Cluster& cl = clusters[c];
+            const int n = cl.size();
+            auto& pc = particleCell_[c];
+            pc.resize(n);
+            for (int i = 0; i < n; ++i) {
+                const int   cell = cellOf(cl.posX[i], cl.posY[i]);
+                const float v2   = cl.velX[i] * cl.velX[i] + cl.velY[i] * cl.velY[i];
+                pc[i] = cell;
+                cellMaxV2_[cell] = std::max(cellMaxV2_[cell], v2);
+            }
+        }
+
+        const float sleepV2 = sleepSpeed * sleepSpeed;
+        for (int k = 0; k < cells; ++k) {
+            if (cellMaxV2_[k] < sleepV2)
+                stillFrames_[k] = (uint16_t)std::min<int>(stillFrames_[k] + 1, 0xffff);
+            else
+                stillFrames_[k] = 0;
+        }
+
+        refreshCells(sleepFrames);
+        refreshParticles(clusters);
+    }
+
+    // Wakes every cell overlapping the circle (and, through the neighbor rule,
+    // the ring around it). Flags are refreshed immediately so the next update
+    // already integrates the disturbed particles.
+    void wake(float x, float y, float radius,
+              std::vector<Cluster>& clusters, int sleepFrames)
+    {
+        if (cols_ == 0 || rows_ == 0) return;
+        const int cx0 = std::clamp((int)((x - radius - offX_) / cellSize_), 0, cols_ - 1);
+        const int cx1 = std::clamp((int)((x + radius - offX_) / cellSize_), 0, cols_ - 1);
+        const int cy0 = std::clamp((int)((y - radius - offY_) / cellSize_), 0, rows_ - 1);
+        const int cy1 = std::clamp((int)((y + radius - offY_) / cellSize_), 0, rows_ - 1);
+        for (int gy = cy0; gy <= cy1; ++gy)
+            for (int gx = cx0; gx <= cx1; ++gx)
+                stillFrames_[gy * cols_ + gx] = 0;
+
+        refreshCells(sleepFrames);
+        refreshParticles(clusters);
+    }
+
+    void wakeAll(std::vector<Cluster>& clusters) {
+        std::fill(stillFrames_.begin(), stillFrames_.end(), 0);
+        std::fill(cellAsleep_.begin(), cellAsleep_.end(), 0);
+        activeCells_ = cols_ * rows_;
+        for (auto& c : clusters) c.asleep.clear();
+    }
+};
+
+} // namespace ParticleLife
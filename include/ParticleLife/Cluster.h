@@ -1,7 +1,13 @@
 #pragma once
 
 #include "ParticleLife.h"
+#include "RuleKernel.h"
 #include "Core/SpatialGrid.h"
+#include "Core/Scratch.h"
+#include "Core/Profiler.h"
+#include "Core/Camera2D.h"
+#include "Core/CircleBatch.h"
+#include "Core/LineBatch.h"
 
 #include <SDL3/SDL.h>
 #include <vector>
@@ -16,23 +22,28 @@ public:
     std::vector<float> posX, posY;
     std::vector<float> velX, velY;
 
+    // Per-particle sleep flags written by ActivityGrid (empty = all awake).
+    // Sleeping particles are skipped by rule().
+    std::vector<uint8_t> asleep;
+
 private:
     Color color_;
 
-    mutable SpatialGrid grid_;
-
-    // Scanline half-widths for filled-circle rendering (indexed by dy + radius).
-    // Recomputed only when the radius changes.
-    mutable std::vector<int> scanlineCache_;
-    mutable int              lastRadius_ = -1;
-
-    void ensureScanlineCache(int radius) const {
-        if (radius == lastRadius_) return;
-        lastRadius_ = radius;
-        scanlineCache_.resize(2 * radius + 1);
-        for (int dy = -radius; dy <= radius; ++dy)
-            scanlineCache_[dy + radius] = (int)sqrtf((float)(radius * radius - dy * dy));
-    }
+    // Rule / connection grid: scratch, so copies of a cluster (snapshots)
+    // do not carry it and an assigned-to cluster drops its stale one
+    mutable Scratch<SpatialGrid> grid_;
+
+    // Same-cluster links recorded by a self-rule (see requestLinks())
+    struct Links {
+        float radius         = 0.f;      // 0 = not requested
+        int   maxPerParticle = 0;
+        std::vector<int>     slots;      // [i * maxPerParticle + k]
+        std::vector<uint8_t> count;      // used slots per particle
+        bool  fresh          = false;    // written by the last update
+        float writtenRadius  = 0.f;      // request the slots were written under
+        int   writtenMax     = 0;
+    };
+    Links links_;
 
 public:
     Cluster() = default;
@@ -46,13 +57,17 @@ public:
     void clear() {
         posX.clear(); posY.clear();
         velX.clear(); velY.clear();
+        asleep.clear();
+        links_.count.clear();
     }
 
     void resize(int n, float minX, float minY, float maxX, float maxY) {
         posX.resize(n); posY.resize(n);
         velX.resize(n); velY.resize(n);
+        asleep.clear();
+        links_.count.clear();
 
-        static std::mt19937 gen(std::random_device{}());
+        auto& gen = Random::Engine();
         std::uniform_real_distribution<float> dX(minX, maxX);
         std::uniform_real_distribution<float> dY(minY, maxY);
         std::uniform_real_distribution<float> dV(-0.5f, 0.5f);
@@ -63,6 +78,27 @@ public:
         }
     }
 
+    // ── Connection links ──────────────────────────────────────────────────
+    // Asks the next self-rule (rule() with other == *this) to record, for
+    // each particle i, the first maxPerParticle partners j > i closer than
+    // radius, as a by-product of its neighbour traversal. Only recorded
+    // when radius fits in that rule's grid cells (radius <= rule radius);
+    // pairs that are neighbours only across the wrap seam are skipped.
+    // radius <= 0 turns the output off. Call once per update, before rules.
+    // Sleeping particles keep their slots, except on the pass after the
+    // radius or maximum changes, which rewrites them for every particle.
+    void requestLinks(float radius, int maxPerParticle) {
+        links_.radius         = radius;
+        links_.maxPerParticle = std::clamp(maxPerParticle, 0, 255);
+        links_.fresh          = false;
+    }
+
+    bool hasLinks(float radius, int maxPerParticle) const {
+        return links_.fresh && links_.writtenRadius == radius
+            && links_.writtenMax == maxPerParticle
+            && (int)links_.count.size() == size();
+    }
+
     // ── Physics ───────────────────────────────────────────────────────────
     void rule(const Cluster& other,
               float gravity,  float radius,
@@ -75,73 +111,43 @@ public:
         const int m = (int)other.posX.size();
         if (n == 0 || m == 0) return;
 
-        const float g    = gravity / -100.0f;
-        const float r2   = radius * radius;
-        const float damp = 1.0f - viscosity;
-
+        // Toroidal world: particles wrap at [marginX, screenW-marginX], and
+        // the grid is built in that frame so opposite edges connect.
+        RuleSpace<2> space;
+        space.extent[0] = screenW;                space.extent[1] = screenH;
+        space.period[0] = screenW - 2.f * marginX; space.period[1] = screenH - 2.f * marginY;
+        space.origin[0] = wrapping ? marginX : 0.f;
+        space.origin[1] = wrapping ? marginY : 0.f;
+        space.wrapping  = wrapping;
+
+        // Link output: sleeping particles keep their slots unless the slot
+        // layout or radius changed, when they are rewritten for everyone
         const float cs   = std::max(radius, 1.0f);
-
-        // Toroidal world dimensions — particles wrap at [marginX, screenW-marginX].
-        const float worldW = screenW - 2.f * marginX;
-        const float worldH = screenH - 2.f * marginY;
-        const float halfW  = worldW * 0.5f;
-        const float halfH  = worldH * 0.5f;
-
-        // When wrapping, build the grid in world-space ([0,worldW] x [0,worldH])
-        // so forEachNeighborWrapped correctly connects opposite edges.
-        int   cols, rows;
-        float offX = 0.f, offY = 0.f;
-        if (wrapping) {
-            cols = std::max(1, (int)(worldW / cs) + 1);
-            rows = std::max(1, (int)(worldH / cs) + 1);
-            offX = marginX;
-            offY = marginY;
-        } else {
-            cols = std::max(1, (int)(screenW / cs) + 2);
-            rows = std::max(1, (int)(screenH / cs) + 2);
+        const bool  emit = &other == this && links_.radius > 0.f
+                        && links_.radius <= cs && links_.maxPerParticle > 0;
+        RuleLinks links{};
+        if (emit) {
+            const bool rewrite = (int)links_.count.size() != n
+                              || links_.writtenRadius != links_.radius
+                              || links_.writtenMax    != links_.maxPerParticle;
+            if (rewrite) links_.count.assign(n, 0);
+            links_.slots.resize((size_t)n * links_.maxPerParticle);
+            links = { links_.radius * links_.radius, links_.maxPerParticle,
+                      links_.slots.data(), links_.count.data(), rewrite };
         }
 
-        other.grid_.build(other.posX.data(), other.posY.data(), m, cs, cols, rows, offX, offY);
-
-        const float* opx = other.posX.data();
-        const float* opy = other.posY.data();
-
-        #pragma omp parallel for schedule(static)
-        for (int i = 0; i < n; ++i) {
-            float fx = 0.f, fy = 0.f;
-            const float px = posX[i];
-            const float py = posY[i];
-
-            const int cx0 = std::clamp((int)((px - offX) / cs), 0, cols - 1);
-            const int cy0 = std::clamp((int)((py - offY) / cs), 0, rows - 1);
-
-            auto process = [&](int j) {
-                float ddx = px - opx[j];
-                float ddy = py - opy[j];
-                if (wrapping) {
-                    // Shortest-path (toroidal) distance
-                    if      (ddx >  halfW) ddx -= worldW;
-                    else if (ddx < -halfW) ddx += worldW;
-                    if      (ddy >  halfH) ddy -= worldH;
-                    else if (ddy < -halfH) ddy += worldH;
-                }
-                const float d2 = ddx * ddx + ddy * ddy;
-                if (d2 > 0.f && d2 < r2) {
-                    const float inv_d = 1.f / sqrtf(d2);
-                    fx += ddx * inv_d;
-                    fy += ddy * inv_d;
-                }
-            };
-
-            if (wrapping)
-                other.grid_.forEachNeighborWrapped(cx0, cy0, cols, rows, process);
-            else
-                other.grid_.forEachNeighbor(cx0, cy0, cols, rows, process);
-
-            velX[i] = (velX[i] + fx * g) * damp;
-            velY[i] = (velY[i] + fy * g) * damp + worldGravity;
-            posX[i] += velX[i];
-            posY[i] += velY[i];
+        float* const       pos[2]  = { posX.data(), posY.data() };
+        float* const       vel[2]  = { velX.data(), velY.data() };
+        const float* const opos[2] = { other.posX.data(), other.posY.data() };
+        const uint8_t* sleeping = ((int)asleep.size() == n) ? asleep.data() : nullptr;
+
+        ApplyRule<2>(other.grid_, pos, vel, n, opos, m, space,
+                     { gravity, radius, viscosity, worldGravity },
+                     sleeping, emit ? &links : nullptr);
+        if (emit) {
+            links_.fresh         = true;
+            links_.writtenRadius = links_.radius;
+            links_.writtenMax    = links_.maxPerParticle;
         }
     }
 
@@ -162,27 +168,17 @@ public:
 
         grid_.build(posX.data(), posY.data(), n, cs, cols, rows);
 
-        const int cx0 = std::clamp((int)((mouseX - radius) / cs), 0, cols - 1);
-        const int cx1 = std::clamp((int)((mouseX + radius) / cs), 0, cols - 1);
-        const int cy0 = std::clamp((int)((mouseY - radius) / cs), 0, rows - 1);
-        const int cy1 = std::clamp((int)((mouseY + radius) / cs), 0, rows - 1);
-
-        for (int gy = cy0; gy <= cy1; ++gy) {
-            for (int gx = cx0; gx <= cx1; ++gx) {
-                const int cell = gy * cols + gx;
-                for (int k = grid_.start[cell], end = grid_.start[cell + 1]; k < end; ++k) {
-                    const int   i   = grid_.idx[k];
-                    const float dx  = posX[i] - mouseX;
-                    const float dy  = posY[i] - mouseY;
-                    const float d2  = dx * dx + dy * dy;
-                    if (d2 > 0.f && d2 < r2) {
-                        const float inv_d = 1.f / sqrtf(d2);
-                        velX[i] += dx * inv_d * strength;
-                        velY[i] += dy * inv_d * strength;
-                    }
-                }
+        grid_.forEachInRect(mouseX - radius, mouseY - radius,
+                            mouseX + radius, mouseY + radius, [&](int i) {
+            const float dx  = posX[i] - mouseX;
+            const float dy  = posY[i] - mouseY;
+            const float d2  = dx * dx + dy * dy;
+            if (d2 > 0.f && d2 < r2) {
+                const float inv_d = 1.f / sqrtf(d2);
+                velX[i] += dx * inv_d * strength;
+                velY[i] += dy * inv_d * strength;
             }
-        }
+        });
     }
 
     // ── Boundaries ────────────────────────────────────────────────────────
@@ -207,36 +203,60 @@ public:
     }
 
     // ── Rendering ─────────────────────────────────────────────────────────
-    void draw(SDL_Renderer* renderer, int radius) const {
-        SDL_SetRenderDrawColor(renderer, color_.r, color_.g, color_.b, color_.a);
+    // Calls func(i) for every particle inside the world rectangle.  Uses the
+    // grid left over from the physics pass when it still indexes this
+    // cluster (query padded by one cell to absorb one frame of motion),
+    // otherwise falls back to a linear scan.
+    template<typename Func>
+    void forEachInView(float x0, float y0, float x1, float y1, const Func& func) const {
         const int n = (int)posX.size();
-
-        if (radius <= 1) {
-            for (int i = 0; i < n; ++i)
-                SDL_RenderPoint(renderer, posX[i], posY[i]);
+        auto visit = [&](int i) {
+            const float x = posX[i], y = posY[i];
+            if (x >= x0 && x <= x1 && y >= y0 && y <= y1) func(i);
+        };
+        if ((int)grid_.idx.size() == n && grid_.layoutCols > 0) {
+            const float pad = grid_.layoutCellSize;
+            grid_.forEachInRect(x0 - pad, y0 - pad, x1 + pad, y1 + pad, visit);
         } else {
-            ensureScanlineCache(radius);
-            for (int i = 0; i < n; ++i) {
-                const int cx = (int)posX[i];
-                const int cy = (int)posY[i];
-                for (int dy = -radius; dy <= radius; ++dy)
-                    SDL_RenderLine(renderer,
-                                   cx - scanlineCache_[dy + radius], cy + dy,
-                                   cx + scanlineCache_[dy + radius], cy + dy);
-            }
+            for (int i = 0; i < n; ++i) visit(i);
         }
     }
 
+    // Appends the visible particles to the batch; radius is in screen pixels
+    // (already scaled by the camera zoom).
+    void draw(CircleBatch& batch, int radius, const Camera2D& cam) const {
+        const SDL_FColor col = CircleBatch::ToFColor(color_.r, color_.g, color_.b, color_.a);
+
+        float x0, y0, x1, y1;
+        cam.visibleRect(x0, y0, x1, y1);
+        const float pad = radius / cam.zoom;
+        x0 -= pad; y0 -= pad; x1 += pad; y1 += pad;
+
+        forEachInView(x0, y0, x1, y1, [&](int i) {
+            batch.add(cam.worldToScreenX(posX[i]), cam.worldToScreenY(posY[i]), radius, col);
+        });
+    }
+
     // ── Connection lines (same-cluster, spatial grid) ─────────────────────
-    // Draws lines between particles within connectionRadius at ~40% opacity.
-    void drawConnections(SDL_Renderer* renderer,
+    // Appends lines between particles within connectionRadius at ~40%
+    // opacity. Only particles within connectionRadius of the view are
+    // considered. Uses the links recorded by this update's self-rule when
+    // they match (see requestLinks()), otherwise queries its own grid with
+    // rows split across threads; each thread writes its own LineBatch buffer.
+    void drawConnections(LineBatch& batch,
                          float screenW, float screenH,
                          float connectionRadius,
-                         int   maxConnections) const
+                         int   maxConnections,
+                         const Camera2D& cam) const
     {
         const int n = (int)posX.size();
         if (n < 2) return;
 
+        if (hasLinks(connectionRadius, maxConnections)) {
+            drawLinks(batch, connectionRadius, cam);
+            return;
+        }
+
         const float cs   = std::max(connectionRadius, 1.0f);
         const int   cols = std::max(1, (int)(screenW / cs) + 2);
         const int   rows = std::max(1, (int)(screenH / cs) + 2);
@@ -245,29 +265,80 @@ public:
 
         const float r2 = connectionRadius * connectionRadius;
 
-        SDL_SetRenderDrawColor(renderer, color_.r, color_.g, color_.b, 100);
+        float x0, y0, x1, y1;
+        cam.visibleRect(x0, y0, x1, y1);
+        x0 -= cs; y0 -= cs; x1 += cs; y1 += cs;
 
-        for (int i = 0; i < n; ++i) {
-            const float px = posX[i];
-            const float py = posY[i];
+        const int cxA = std::clamp((int)(x0 / cs), 0, cols - 1);
+        const int cxB = std::clamp((int)(x1 / cs), 0, cols - 1);
+        const int cyA = std::clamp((int)(y0 / cs), 0, rows - 1);
+        const int cyB = std::clamp((int)(y1 / cs), 0, rows - 1);
+
+        const SDL_FColor col = CircleBatch::ToFColor(color_.r, color_.g, color_.b, 100);
+
+        #pragma omp parallel for schedule(static)
+        for (int cy0 = cyA; cy0 <= cyB; ++cy0) {
+            const int thread = LineBatch::Thread();
+            for (int cx0 = cxA; cx0 <= cxB; ++cx0) {
+                const int cell = cy0 * cols + cx0;
+                for (int k = grid_.start[cell]; k < grid_.start[cell + 1]; ++k) {
+                    const int   i  = grid_.idx[k];
+                    const float px = posX[i];
+                    const float py = posY[i];
+                    if (px < x0 || px > x1 || py < y0 || py > y1) continue;
+
+                    int connCount = 0;
+                    grid_.forEachNeighbor(cx0, cy0, cols, rows, [&](int j) {
+                        if (j <= i || connCount >= maxConnections) return;
+
+                        const float ddx = px - posX[j];
+                        const float ddy = py - posY[j];
+                        if (ddx * ddx + ddy * ddy < r2) {
+                            batch.add(thread,
+                                      cam.worldToScreenX(px),      cam.worldToScreenY(py),
+                                      cam.worldToScreenX(posX[j]), cam.worldToScreenY(posY[j]),
+                                      col);
+                            ++connCount;
+                        }
+                    });
+                }
+            }
+        }
+    }
 
-            const int cx0 = std::clamp((int)(px / cs), 0, cols - 1);
-            const int cy0 = std::clamp((int)(py / cs), 0, rows - 1);
+private:
+    // Lines from the recorded slots. Particles have moved since the rule
+    // ran, so each link is re-checked against the radius.
+    void drawLinks(LineBatch& batch, float connectionRadius, const Camera2D& cam) const {
+        const int   n  = (int)posX.size();
+        const float cs = std::max(connectionRadius, 1.0f);
+        const float r2 = connectionRadius * connectionRadius;
 
-            int connCount = 0;
+        float x0, y0, x1, y1;
+        cam.visibleRect(x0, y0, x1, y1);
+        x0 -= cs; y0 -= cs; x1 += cs; y1 += cs;
 
-            grid_.forEachNeighbor(cx0, cy0, cols, rows, [&](int j) {
-                if (j <= i || connCount >= maxConnections) return;
+        const SDL_FColor col = CircleBatch::ToFColor(color_.r, color_.g, color_.b, 100);
+        const int maxLinks = links_.maxPerParticle;
 
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < n; ++i) {
+            const float px = posX[i];
+            const float py = posY[i];
+            if (px < x0 || px > x1 || py < y0 || py > y1) continue;
+
+            const int  thread = LineBatch::Thread();
+            const int* slots  = &links_.slots[(size_t)i * maxLinks];
+            for (int k = 0, count = links_.count[i]; k < count; ++k) {
+                const int   j   = slots[k];
                 const float ddx = px - posX[j];
                 const float ddy = py - posY[j];
-                if (ddx * ddx + ddy * ddy < r2) {
-                    SDL_RenderLine(renderer,
-                                   (int)px,      (int)py,
-                                   (int)posX[j], (int)posY[j]);
-                    ++connCount;
-                }
-            });
+                if (ddx * ddx + ddy * ddy >= r2) continue;
+                batch.add(thread,
+                          cam.worldToScreenX(px),      cam.worldToScreenY(py),
+                          cam.worldToScreenX(posX[j]), cam.worldToScreenY(posY[j]),
+                          col);
+            }
         }
     }
 };
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "ParticleLife.h"
+#include "RuleKernel.h"
+#include "Core/SpatialGrid.h"
+
+#include <vector>
+#include <cmath>
+#include <random>
+#include <algorithm>
+
+namespace ParticleLife {
+
+// 3D variant of Cluster: SoA x/y/z arrays stepped by the same ApplyRule()
+// kernel as Cluster::rule(), with a SpatialGrid3D and its 27-cell stencil.
+class Cluster3D {
+public:
+    std::vector<float> posX, posY, posZ;
+    std::vector<float> velX, velY, velZ;
+
+private:
+    Color color_;
+
+    mutable SpatialGrid3D grid_;
+
+public:
+    Cluster3D() = default;
+    explicit Cluster3D(int /*count*/, const Color& col = Color::Random())
+        : color_(col) {}
+
+    void setColor(const Color& c) { color_ = c; }
+    const Color& getColor()       const { return color_; }
+    int          size()           const { return (int)posX.size(); }
+
+    void clear() {
+        posX.clear(); posY.clear(); posZ.clear();
+        velX.clear(); velY.clear(); velZ.clear();
+    }
+
+    void resize(int n, float minX, float minY, float minZ,
+                       float maxX, float maxY, float maxZ) {
+        posX.resize(n); posY.resize(n); posZ.resize(n);
+        velX.resize(n); velY.resize(n); velZ.resize(n);
+
+        auto& gen = Random::Engine();
+        std::uniform_real_distribution<float> dX(minX, maxX);
+        std::uniform_real_distribution<float> dY(minY, maxY);
+        std::uniform_real_distribution<float> dZ(minZ, maxZ);
+        std::uniform_real_distribution<float> dV(-0.5f, 0.5f);
+
+        for (int i = 0; i < n; ++i) {
+            posX[i] = dX(gen);  posY[i] = dY(gen);  posZ[i] = dZ(gen);
+            velX[i] = dV(gen);  velY[i] = dV(gen);  velZ[i] = dV(gen);
+        }
+    }
+
+    // ── Physics ───────────────────────────────────────────────────────────
+    // World is the box [0,worldW] x [0,worldH] x [0,worldD].
+    void rule(const Cluster3D& other,
+              float gravity,  float radius,
+              float viscosity, float worldGravity,
+              float worldW,  float worldH, float worldD,
+              bool  wrapping = false)
+    {
+        const int n = (int)posX.size();
+        const int m = (int)other.posX.size();
+        if (n == 0 || m == 0) return;
+
+        RuleSpace<3> space;
+        space.extent[0] = space.period[0] = worldW;
+        space.extent[1] = space.period[1] = worldH;
+        space.extent[2] = space.period[2] = worldD;
+        space.origin[0] = space.origin[1] = space.origin[2] = 0.f;
+        space.wrapping  = wrapping;
+
+        float* const       pos[3]  = { posX.data(), posY.data(), posZ.data() };
+        float* const       vel[3]  = { velX.data(), velY.data(), velZ.data() };
+        const float* const opos[3] = { other.posX.data(), other.posY.data(), other.posZ.data() };
+
+        ApplyRule<3>(other.grid_, pos, vel, n, opos, m, space,
+                     { gravity, radius, viscosity, worldGravity },
+                     nullptr, nullptr, "Rule 3D worker");
+    }
+
+    // ── Boundaries ────────────────────────────────────────────────────────
+    void applyBoundariesWrapping(float maxX, float maxY, float maxZ) {
+        const int n = (int)posX.size();
+        for (int i = 0; i < n; ++i) {
+            if      (posX[i] <  0.f)  posX[i] += maxX;
+            else if (posX[i] >= maxX) posX[i] -= maxX;
+            if      (posY[i] <  0.f)  posY[i] += maxY;
+            else if (posY[i] >= maxY) posY[i] -= maxY;
+            if      (posZ[i] <  0.f)  posZ[i] += maxZ;
+            else if (posZ[i] >= maxZ) posZ[i] -= maxZ;
+        }
+    }
+
+    void applyBoundariesClamping(float maxX, float maxY, float maxZ) {
+        const int n = (int)posX.size();
+        for (int i = 0; i < n; ++i) {
+            posX[i] = std::clamp(posX[i], 0.f, maxX);
+            posY[i] = std::clamp(posY[i], 0.f, maxY);
+            posZ[i] = std::clamp(posZ[i], 0.f, maxZ);
+        }
+    }
+};
+
+} // namespace ParticleLife
@@ -0,0 +1,214 @@
+#pragma once
+
+#include "Cluster.h"
+#include "Core/SpatialGrid.h"
+#include "Core/Profiler.h"
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace ParticleLife {
+
+/**
+ * Short-range hard-core repulsion between every pair of particles, regardless
+ * of cluster.  Particles are discs of radius `particleRadius`; overlapping
+ * pairs are pushed apart along their axis with a stiff linear spring.
+ *
+ * The correction is resolved in a few cheap substeps that all reuse a single
+ * grid built at the start of solve(): the grid is built with a cell size of
+ * twice the contact distance, so the small displacements produced between
+ * substeps never move a contact out of the 3x3 neighborhood.  The substep
+ * count is derived from the fastest particle so that high-velocity frames
+ * get more iterations and calm frames get one.
+ */
+class CollisionSolver {
+private:
+    // All clusters gathered into one SoA array (cluster c starts at offset_[c]).
+    std::vector<float> px_, py_;
+    std::vector<float> dx_, dy_;
+    std::vector<int>   cellX_, cellY_;
+    std::vector<int>   offset_;
+
+    SpatialGrid grid_;
+
+    int lastSubsteps_ = 0;
+
+    // Deterministic separation axis for exactly coincident particles.
+    // Antisymmetric in (i, j) so that both particles of the pair move apart.
+    static void coincidentAxis(int i, int j, float& nx, float& ny) {
+        const unsigned lo = (unsigned)std::min(i, j);
+        const unsigned hi = (unsigned)std::max(i, j);
+        const unsigned h  = (lo * 73856093u) ^ (hi * 19349663u);
+        const float    a  = (float)(h & 0xffffu) * (6.2831853f / 65536.f);
+        const float    s  = (i < j) ? 1.f : -1.f;
+        nx = cosf(a) * s;
+        ny = sinf(a) * s;
+    }
+
+public:
+    int getLastSubsteps() const { return lastSubsteps_; }
+
+    // Resolves overlaps in place and adds the resulting impulse to velocities.
+    //   particleRadius : hard-core radius of every particle (contact at 2*radius)
+    //   stiffness      : fraction of a pair's overlap removed per substep, in
+    //                    (0, 1]; s substeps remove 1 - (1 - stiffness)^s of it
+    //   maxSubsteps    : upper bound for the velocity-driven substep count
+    // Returns the number of substeps actually used (0 when nothing ran).
+    int solve(std::vector<Cluster>& clusters,
+              float particleRadius, float stiffness, int maxSubsteps,
+              float screenW, float screenH,
+              bool  wrapping = false,
+              float marginX  = 0.f, float marginY = 0.f)
+    {
+        lastSubsteps_ = 0;
+
+        const int nc = (int)clusters.size();
+        offset_.resize(nc + 1);
+        offset_[0] = 0;
+        for (int c = 0; c < nc; ++c)
+            offset_[c + 1] = offset_[c] + clusters[c].size();
+
+        const int n = offset_[nc];
+        if (n < 2 || particleRadius <= 0.f || stiffness <= 0.f) return 0;
+
+        const float contact  = 2.f * particleRadius;
+        const float contact2 = contact * contact;
+
+        // ── Gather + max speed ─────────────────────────────────────────────
+        px_.resize(n); py_.resize(n);
+        dx_.resize(n); dy_.resize(n);
+        cellX_.resize(n); cellY_.resize(n);
+
+        float maxV2 = 0.f;
+        for (int c = 0; c < nc; ++c) {
+            const Cluster& cl = clusters[c];
+            const int      o  = offset_[c];
+            for (int i = 0, m = cl.size(); i < m; ++i) {
+                px_[o + i] = cl.posX[i];
+                py_[o + i] = cl.posY[i];
+                maxV2 = std::max(maxV2, cl.velX[i] * cl.velX[i] + cl.velY[i] * cl.velY[i]);
+            }
+        }
+
+        // One substep per half contact distance travelled by the fastest particle.
+        const int substeps = std::clamp(
+            (int)std::ceil(sqrtf(maxV2) / (0.5f * contact)), 1, std::max(1, maxSubsteps));
+
+        // ── Grid (built once, shared by all substeps) ──────────────────────
+        const float worldW = screenW - 2.f * marginX;
+        const float worldH = screenH - 2.f * marginY;
+        const float halfW  = worldW * 0.5f;
+        const float halfH  = worldH * 0.5f;
+        const float cs     = 2.f * contact;
+
+        int   cols, rows;
+        float offX = 0.f, offY = 0.f;
+        if (wrapping) {
+            // Rounded down so the last cell is never narrower than cs (see Cluster::rule)
+            cols = std::max(1, (int)(worldW / cs));
+            rows = std::max(1, (int)(worldH / cs));
+            offX = marginX;
+            offY = marginY;
+        } else {
+            cols = std::max(1, (int)(screenW / cs) + 2);
+            rows = std::max(1, (int)(screenH / cs) + 2);
+        }
+
+        grid_.build(px_.data(), py_.data(), n, cs, cols, rows, offX, offY);
+
+        for (int i = 0; i < n; ++i) {
+            cellX_[i] = std::clamp((int)((px_[i] - offX) / cs), 0, cols - 1);
+            cellY_[i] = std::clamp((int)((py_[i] - offY) / cs), 0, rows - 1);
+        }
+
+        // ── Substeps (Jacobi: read px_/py_, write dx_/dy_) ─────────────────
+        // Each particle of a pair moves half the corrected overlap. The full
+        // fraction applies in every substep, so extra substeps on fast frames
+        // resolve more of the overlap, not the same amount in smaller pieces.
+        const float k = 0.5f * stiffness;
+
+        for (int s = 0; s < substeps; ++s) {
+            // Serial inside an enclosing parallel region (see Ensemble)
+            #pragma omp parallel if(!omp_in_parallel())
+            {
+                PROFILE_ZONE("Collision worker");
+                #pragma omp for schedule(static)
+                for (int i = 0; i < n; ++i) {
+                    float sx = 0.f, sy = 0.f;
+                    const float xi = px_[i];
+                    const float yi = py_[i];
+
+                    auto process = [&](int j) {
+                        if (j == i) return;
+                        float ddx = xi - px_[j];
+                        float ddy = yi - py_[j];
+                        if (wrapping) {
+                            if      (ddx >  halfW) ddx -= worldW;
+                            else if (ddx < -halfW) ddx += worldW;
+                            if      (ddy >  halfH) ddy -= worldH;
+                            else if (ddy < -halfH) ddy += worldH;
+                        }
+                        const float d2 = ddx * ddx + ddy * ddy;
+                        if (d2 >= contact2) return;
+
+                        float nx, ny, d;
+                        if (d2 > 1e-12f) {
+                            d = sqrtf(d2);
+                            nx = ddx / d;
+                            ny = ddy / d;
+                        } else {
+                            d = 0.f;
+                            coincidentAxis(i, j, nx, ny);
+                        }
+                        const float push = (contact - d) * k;
+                        sx += nx * push;
+                        sy += ny * push;
+                    };
+
+                    if (wrapping)
+                        grid_.forEachNeighborWrapped(cellX_[i], cellY_[i], cols, rows, process);
+                    else
+                        grid_.forEachNeighbor(cellX_[i], cellY_[i], cols, rows, process);
+
+                    dx_[i] = sx;
+                    dy_[i] = sy;
+                }
+            }
+
+            for (int i = 0; i < n; ++i) {
+                px_[i] += dx_[i];
+                py_[i] += dy_[i];
+            }
+
+            // The displacement becomes velocity so that contacts stay resolved.
+            for (int c = 0; c < nc; ++c) {
+                Cluster& cl = clusters[c];
+                const int o = offset_[c];
+                for (int i = 0, m = cl.size(); i < m; ++i) {
+                    cl.velX[i] += dx_[o + i];
+                    cl.velY[i] += dy_[o + i];
+                }
+            }
+        }
+
+        // ── Scatter ────────────────────────────────────────────────────────
+        for (int c = 0; c < nc; ++c) {
+            Cluster& cl = clusters[c];
+            const int o = offset_[c];
+            for (int i = 0, m = cl.size(); i < m; ++i) {
+                cl.posX[i] = px_[o + i];
+                cl.posY[i] = py_[o + i];
+            }
+        }
+
+        lastSubsteps_ = substeps;
+        return substeps;
+    }
+};
+
+} // namespace ParticleLife
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "ParticleLifeSystem.h"
+
+#include <vector>
+#include <chrono>
+#include <algorithm>
+
+namespace ParticleLife {
+
+/**
+ * K independent small ParticleLife worlds stepped together, for rule-matrix
+ * exploration.
+ *
+ * Small worlds parallelise badly on their own (the OpenMP fork/join in
+ * Cluster::rule() costs more than the work at a few thousand particles), so
+ * the ensemble parallelises across worlds instead: one parallel region per
+ * step, one world per thread at a time.  Every grid build and rule of a world
+ * runs on the same core back to back: the rule and collision loops test
+ * omp_in_parallel() and run serially instead of opening nested teams, so
+ * this does not depend on the runtime's max-active-levels setting.
+ *
+ * Grids are still built per rule inside each world, as in a standalone
+ * ParticleLifeSystem; the batching is across worlds, whose builds all run in
+ * the one parallel region.
+ */
+class Ensemble {
+private:
+    std::vector<ParticleLifeSystem> worlds_;
+
+    int    totalParticles_       = 0;
+    double lastStepMs_           = 0.0;
+    double particleUpdatesPerSec_ = 0.0;
+    long long steps_             = 0;
+
+public:
+    // Builds K worlds of `clusters` clusters x `perCluster` particles with
+    // independent random rule matrices.
+    void configure(int worldCount, int clusters, int perCluster,
+                   int worldW, int worldH,
+                   BoundaryMode mode = BoundaryMode::Wrapping)
+    {
+        worlds_.clear();
+        worlds_.resize(std::max(0, worldCount));
+        totalParticles_ = 0;
+        steps_ = 0;
+
+        for (auto& w : worlds_) {
+            w.setBoundaryMode(mode);
+            w.setScreenSize(worldW, worldH);
+            w.setWorldSize(worldW, worldH);
+            for (int c = 0; c < clusters; ++c)
+                w.addCluster(perCluster);
+            w.generateRandomRules(-100.f, 100.f, 10.f, 200.f);
+            totalParticles_ += w.getTotalParticles();
+        }
+    }
+
+    void clear() { worlds_.clear(); totalParticles_ = 0; steps_ = 0; }
+
+    void step() {
+        const int k = (int)worlds_.size();
+        if (k == 0) return;
+
+        PROFILE_ZONE("Ensemble step");
+        ALLOC_SCOPE("Ensemble");
+        const auto t0 = std::chrono::steady_clock::now();
+
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (int w = 0; w < k; ++w)
+            worlds_[w].update();
+
+        const auto t1 = std::chrono::steady_clock::now();
+        lastStepMs_ = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        particleUpdatesPerSec_ = lastStepMs_ > 0.0
+            ? totalParticles_ * 1000.0 / lastStepMs_ : 0.0;
+        ++steps_;
+    }
+
+    void randomiseAllRules() {
+        for (auto& w : worlds_)
+            w.generateRandomRules(-100.f, 100.f, 10.f, 200.f);
+    }
+
+    void resetAllPositions() {
+        for (auto& w : worlds_)
+            w.resetPositions();
+    }
+
+    // ── Accessors ─────────────────────────────────────────────────────────
+    int       getWorldCount()            const { return (int)worlds_.size(); }
+    int       getTotalParticles()        const { return totalParticles_; }
+    double    getLastStepMs()            const { return lastStepMs_; }
+    double    getParticleUpdatesPerSec() const { return particleUpdatesPerSec_; }
+    long long getStepCount()             const { return steps_; }
+
+    ParticleLifeSystem&       getWorld(int i)       { return worlds_[i]; }
+    const ParticleLifeSystem& getWorld(int i) const { return worlds_[i]; }
+};
+
+} // namespace ParticleLife
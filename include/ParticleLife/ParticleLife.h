@@ -3,6 +3,8 @@
 #include <cstdint>
 #include <random>
 
+#include "Core/Random.h"
+
 namespace ParticleLife {
 
 /**
@@ -26,9 +28,8 @@ struct Color {
     static Color White()   { return Color(255, 255, 255); }
 
     static Color Random() {
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
-        static std::uniform_int_distribution<int> dist(100, 255);
+        auto& gen = ::Random::Engine();
+        std::uniform_int_distribution<int> dist(100, 255);
         return Color(
             (uint8_t)dist(gen),
             (uint8_t)dist(gen),
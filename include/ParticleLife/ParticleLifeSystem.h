@@ -1,6 +1,15 @@
 #pragma once
 
 #include "Cluster.h"
+#include "CollisionSolver.h"
+#include "ActivityGrid.h"
+#include "Core/StageTimer.h"
+#include "Core/Profiler.h"
+#include "Core/AllocTracker.h"
+#include "Core/ParticleSplatter.h"
+#include "Core/DensityMap.h"
+#include "Core/TrailHistory.h"
+#include "Core/Scratch.h"
 #include <SDL3/SDL.h>
 #include <nlohmann/json.hpp>
 #include <fstream>
@@ -17,6 +26,13 @@ enum class BoundaryMode {
     Clamping,
 };
 
+// How draw() puts particles on screen
+enum class RenderMode {
+    Sprites,   // CircleBatch: textured quads, one SDL_RenderGeometry call
+    Splat,     // ParticleSplatter: multithreaded CPU raster, one texture upload
+    Density,   // DensityMap: per-cell counts coloured per pixel, cost O(pixels)
+};
+
 struct Rule {
     int   clusterA;
     int   clusterB;
@@ -38,6 +54,27 @@ private:
     float        particleSize_ = 3.0f;
     BoundaryMode boundaryMode_ = BoundaryMode::Clamping;
 
+    // Collision core (hard-core repulsion, radius = particleSize_)
+    bool            collisionEnabled_   = false;
+    float           collisionStiffness_ = 0.5f;
+    int             maxSubsteps_        = 8;
+    Scratch<CollisionSolver> collisionSolver_;
+
+    // Sleeping regions (skip cells that reached equilibrium)
+    bool         sleepingEnabled_ = false;
+    float        sleepSpeed_      = 0.05f;   // px/frame below which a cell counts as still
+    int          sleepFrames_     = 30;      // still frames before a region sleeps
+    ActivityGrid activity_;
+
+    // Largest rule radius — the activity cell size (all interactions stay in 3x3 cells).
+    float maxRuleRadius() const {
+        float r = 1.f;
+        for (const auto& rule : rules_) r = std::max(r, rule.radius);
+        return r;
+    }
+
+    void wakeAll() { activity_.wakeAll(clusters_); }
+
     // Mouse interaction
     float mouseRadius_   = 200.0f;
     float mouseStrength_ = 5.0f;
@@ -46,20 +83,74 @@ private:
     bool  showConnections_  = false;
     float connectionRadius_ = 50.0f;
     int   maxConnections_   = 5;
+    bool  physicsLinks_     = true;   // take connections from the self-rules
+    int   linkedClusters_   = 0;      // clusters drawn from physics links last frame
 
-    // Bounds
+    // Bounds — the world is the physical simulation domain and is independent
+    // of the window; screenW_/screenH_ only size the camera viewport.
     float marginX_ = 50.0f;
     float marginY_ = 50.0f;
+    int   worldW_  = 1920;
+    int   worldH_  = 1080;
     int   screenW_ = 1920;
     int   screenH_ = 1080;
 
+    // Render caches are Scratch: copies of the system (the simulation
+    // thread's published snapshot) carry state and settings, not buffers
+    Camera2D             camera_;
+    RenderMode           renderMode_ = RenderMode::Sprites;
+    Scratch<CircleBatch> circles_;   // all clusters' particles, one draw call
+    Scratch<LineBatch>   lines_;     // connections, one buffer per thread
+
+    Scratch<ParticleSplatter>                     splatter_;
+    Scratch<DensityMap>                           density_;
+    DensityMap::Coloring                          densityColoring_ = DensityMap::Coloring::ClusterBlend;
+    int                                           densityCellSize_ = 2;   // screen pixels per cell
+    Scratch<std::vector<ParticleSplatter::Layer>> renderLayers_;          // one per cluster
+
+    // Render interpolation: positions saved by storePreviousPositions() and
+    // the blend drawn at interpolation_ (0 = saved, 1 = current)
+    std::vector<std::vector<float>>          prevX_, prevY_;
+    Scratch<std::vector<std::vector<float>>> blendX_, blendY_;
+    float                                    interpolation_ = 1.0f;
+
+    // Polyline trails of a subset, indexed over the clusters in order
+    TrailHistory     trails_;
+    std::vector<int> clusterStarts_;   // first global index of each cluster
+
     int totalParticles_ = 0;
 
+    StageTimings timings_;
+
 public:
     ParticleLifeSystem() = default;
 
-    // ── Screen ────────────────────────────────────────────────────────────
-    void setScreenSize(int w, int h) { screenW_ = w; screenH_ = h; }
+    // ── Screen / World ────────────────────────────────────────────────────
+    void setScreenSize(int w, int h) {
+        screenW_ = w; screenH_ = h;
+        camera_.setViewport((float)w, (float)h);
+    }
+
+    // Changes the physical domain. Particles are re-scattered over the new
+    // bounds and the camera is re-fitted.
+    void setWorldSize(int w, int h) {
+        worldW_ = std::max(w, (int)(2.f * marginX_) + 1);
+        worldH_ = std::max(h, (int)(2.f * marginY_) + 1);
+        resetPositions();
+        fitCamera();
+    }
+
+    int getWorldWidth()  const { return worldW_; }
+    int getWorldHeight() const { return worldH_; }
+
+    TrailHistory&   getTrailHistory() { return trails_; }
+    Camera2D&       getCamera()       { return camera_; }
+    const Camera2D& getCamera() const { return camera_; }
+
+    void fitCamera() { camera_.fit(0.f, 0.f, (float)worldW_, (float)worldH_); }
+
+    float screenToWorldX(float x) const { return camera_.screenToWorldX(x); }
+    float screenToWorldY(float y) const { return camera_.screenToWorldY(y); }
 
     // ── Getters / Setters ─────────────────────────────────────────────────
     float        getViscosity()        const { return viscosity_;        }
@@ -69,28 +160,57 @@ public:
     float        getMouseRadius()      const { return mouseRadius_;      }
     float        getMouseStrength()    const { return mouseStrength_;    }
     bool         getShowConnections()  const { return showConnections_;  }
+    RenderMode   getRenderMode()       const { return renderMode_;       }
+    int          getDensityCellSize()  const { return densityCellSize_;  }
+    float        getInterpolation()    const { return interpolation_;    }
+    DensityMap::Coloring getDensityColoring() const { return densityColoring_; }
     float        getConnectionRadius() const { return connectionRadius_; }
+    bool         getPhysicsLinks()     const { return physicsLinks_;     }
+    int          getLinkedClusters()   const { return linkedClusters_;   }
     int          getMaxConnections()   const { return maxConnections_;   }
-
-    void setViscosity       (float v)        { viscosity_        = v; }
-    void setWorldGravity    (float g)        { worldGravity_     = g; }
+    bool         getCollisionEnabled()   const { return collisionEnabled_;   }
+    float        getCollisionStiffness() const { return collisionStiffness_; }
+    int          getMaxSubsteps()        const { return maxSubsteps_;        }
+    int          getLastSubsteps()       const { return collisionSolver_.getLastSubsteps(); }
+    bool         getSleepingEnabled()    const { return sleepingEnabled_;    }
+    float        getSleepSpeed()         const { return sleepSpeed_;         }
+    int          getSleepFrames()        const { return sleepFrames_;        }
+    int          getActiveCells()        const { return sleepingEnabled_ ? activity_.getActiveCells()
+                                                                         : activity_.getTotalCells(); }
+    int          getTotalCells()         const { return activity_.getTotalCells(); }
+
+    void setViscosity       (float v)        { viscosity_        = v; wakeAll(); }
+    void setWorldGravity    (float g)        { worldGravity_     = g; wakeAll(); }
     void setParticleSize    (float s)        { particleSize_     = s; }
     void setBoundaryMode    (BoundaryMode m) { boundaryMode_     = m; }
     void setMouseRadius     (float r)        { mouseRadius_      = r; }
     void setMouseStrength   (float s)        { mouseStrength_    = s; }
     void setShowConnections (bool b)         { showConnections_  = b; }
+    void setRenderMode      (RenderMode m)   { renderMode_       = m; }
+    void setDensityCellSize (int px)         { densityCellSize_  = std::max(1, px); }
+    void setInterpolation   (float a)        { interpolation_    = std::clamp(a, 0.f, 1.f); }
+    void setDensityColoring (DensityMap::Coloring c) { densityColoring_ = c; }
     void setConnectionRadius(float r)        { connectionRadius_ = r; }
+    void setPhysicsLinks    (bool b)         { physicsLinks_     = b; }
     void setMaxConnections  (int n)          { maxConnections_   = n; }
+    void setCollisionEnabled  (bool b)  { collisionEnabled_   = b; }
+    void setCollisionStiffness(float k) { collisionStiffness_ = std::clamp(k, 0.f, 1.f); }
+    void setMaxSubsteps       (int n)   { maxSubsteps_        = std::max(1, n); }
+    void setSleepingEnabled   (bool b)  { sleepingEnabled_ = b; wakeAll(); }
+    void setSleepSpeed        (float v) { sleepSpeed_      = std::max(0.f, v); }
+    void setSleepFrames       (int n)   { sleepFrames_     = std::max(1, n); }
 
     // ── Clusters ──────────────────────────────────────────────────────────
     int addCluster(int count, const Color& color = Color::Random()) {
         Cluster c(count, color);
         c.resize(count,
                  marginX_, marginY_,
-                 (float)screenW_ - marginX_,
-                 (float)screenH_ - marginY_);
+                 (float)worldW_ - marginX_,
+                 (float)worldH_ - marginY_);
         clusters_.push_back(std::move(c));
         totalParticles_ += count;
+        trails_.reset();
+        wakeAll();
         return (int)clusters_.size() - 1;
     }
 
@@ -104,6 +224,8 @@ public:
                     return r.clusterA == idx || r.clusterB == idx;
                 }),
             rules_.end());
+        trails_.reset();
+        wakeAll();
     }
 
     void resizeCluster(int idx, int newSize) {
@@ -111,9 +233,11 @@ public:
         totalParticles_ -= clusters_[idx].size();
         clusters_[idx].resize(newSize,
                               marginX_, marginY_,
-                              (float)screenW_ - marginX_,
-                              (float)screenH_ - marginY_);
+                              (float)worldW_ - marginX_,
+                              (float)worldH_ - marginY_);
         totalParticles_ += newSize;
+        trails_.reset();
+        wakeAll();
     }
 
     void setClusterColor(int idx, const Color& c) {
@@ -124,26 +248,32 @@ public:
     // ── Rules ─────────────────────────────────────────────────────────────
     void addRule(int a, int b, float gravity, float radius = 200.0f) {
         rules_.emplace_back(a, b, gravity, radius);
+        wakeAll();
     }
 
     void setRule(int idx, float gravity, float radius) {
         if (idx >= 0 && idx < (int)rules_.size()) {
             rules_[idx].gravity = gravity;
             rules_[idx].radius  = radius;
+            wakeAll();
         }
     }
 
     void removeRule(int idx) {
         if (idx >= 0 && idx < (int)rules_.size())
             rules_.erase(rules_.begin() + idx);
+        wakeAll();
     }
 
-    void clearRules() { rules_.clear(); }
+    void clearRules() { rules_.clear(); wakeAll(); }
 
     void clear() {
         clusters_.clear();
         rules_.clear();
         totalParticles_ = 0;
+        trails_.reset();
+        prevX_.clear();
+        prevY_.clear();
     }
 
     // ── Presets ───────────────────────────────────────────────────────────
@@ -174,8 +304,7 @@ public:
                               float minR =   10.f, float maxR = 200.f)
     {
         clearRules();
-        static std::random_device rd;
-        static std::mt19937 gen(rd());
+        auto& gen = Random::Engine();
         std::uniform_real_distribution<float> dG(minG, maxG);
         std::uniform_real_distribution<float> dR(minR, maxR);
         for (int i = 0; i < (int)clusters_.size(); ++i)
@@ -198,6 +327,18 @@ public:
                               ? "wrapping" : "clamping";
         j["mouseRadius"]    = mouseRadius_;
         j["mouseStrength"]  = mouseStrength_;
+        j["sleeping"]       = {
+            { "enabled", sleepingEnabled_ },
+            { "speed",   sleepSpeed_      },
+            { "frames",  sleepFrames_     }
+        };
+        j["worldWidth"]     = worldW_;
+        j["worldHeight"]    = worldH_;
+        j["collision"]      = {
+            { "enabled",     collisionEnabled_   },
+            { "stiffness",   collisionStiffness_ },
+            { "maxSubsteps", maxSubsteps_        }
+        };
 
         j["clusters"] = json::array();
         for (const auto& c : clusters_) {
@@ -238,6 +379,29 @@ public:
         mouseRadius_  = j.value("mouseRadius",  200.0f);
         mouseStrength_= j.value("mouseStrength", 5.0f);
 
+        if (j.contains("collision")) {
+            const auto& jc = j["collision"];
+            collisionEnabled_   = jc.value("enabled",     false);
+            collisionStiffness_ = jc.value("stiffness",   0.5f);
+            maxSubsteps_        = std::max(1, jc.value("maxSubsteps", 8));
+        } else {
+            collisionEnabled_ = false;
+        }
+
+        if (j.contains("sleeping")) {
+            const auto& js = j["sleeping"];
+            sleepingEnabled_ = js.value("enabled", false);
+            sleepSpeed_      = js.value("speed",   0.05f);
+            sleepFrames_     = std::max(1, js.value("frames", 30));
+        } else {
+            sleepingEnabled_ = false;
+        }
+
+        // Presets saved before world/window decoupling keep the current world.
+        worldW_ = std::max(j.value("worldWidth",  worldW_), (int)(2.f * marginX_) + 1);
+        worldH_ = std::max(j.value("worldHeight", worldH_), (int)(2.f * marginY_) + 1);
+        fitCamera();
+
         std::string modeStr = j.value("boundaryMode", "wrapping");
         boundaryMode_ = (modeStr == "clamping")
                         ? BoundaryMode::Clamping : BoundaryMode::Wrapping;
@@ -273,13 +437,21 @@ public:
 
     // ── Update ────────────────────────────────────────────────────────────
     void update() {
-        const float sw = (float)screenW_;
-        const float sh = (float)screenH_;
+        const float sw = (float)worldW_;
+        const float sh = (float)worldH_;
+
+        ALLOC_SCOPE("ParticleLife");
+        StageClock clock(timings_);
+
+        const bool links = showConnections_ && physicsLinks_;
+        for (auto& c : clusters_)
+            c.requestLinks(links ? connectionRadius_ : 0.f, maxConnections_);
 
         for (const auto& rule : rules_) {
             if (rule.clusterA < (int)clusters_.size() &&
                 rule.clusterB < (int)clusters_.size())
             {
+                PROFILE_ZONE("Rule");
                 clusters_[rule.clusterA].rule(
                     clusters_[rule.clusterB],
                     rule.gravity, rule.radius,
@@ -291,47 +463,139 @@ public:
             }
         }
 
+        clock.lap("rules");
+
+        if (collisionEnabled_) {
+            PROFILE_ZONE("Collisions");
+            collisionSolver_.solve(clusters_,
+                                   particleSize_, collisionStiffness_, maxSubsteps_,
+                                   sw, sh,
+                                   boundaryMode_ == BoundaryMode::Wrapping,
+                                   marginX_, marginY_);
+            clock.lap("collisions");
+        }
+
         for (auto& c : clusters_) {
+            PROFILE_ZONE("Integrate boundaries");
             if (boundaryMode_ == BoundaryMode::Wrapping)
                 c.applyBoundariesWrapping(marginX_, marginY_, sw - marginX_, sh - marginY_);
             else
                 c.applyBoundariesClamping(marginX_, marginY_, sw - marginX_, sh - marginY_);
         }
+        clock.lap("boundaries");
+
+        if (sleepingEnabled_) {
+            PROFILE_ZONE("Sleeping");
+            activity_.configure(maxRuleRadius(), sw, sh,
+                                boundaryMode_ == BoundaryMode::Wrapping,
+                                marginX_, marginY_);
+            activity_.track(clusters_, sleepSpeed_, sleepFrames_);
+            clock.lap("sleeping");
+        }
+
+        if (trails_.getTracks() > 0) {
+            recordTrails();
+            clock.lap("trails");
+        }
     }
 
     // ── Mouse interaction ─────────────────────────────────────────────────
+    // mouseX/mouseY and radius are in world units (see screenToWorldX/Y).
     void applyMouseForce(float mouseX, float mouseY, float strength, float radius) {
-        const float sw = (float)screenW_;
-        const float sh = (float)screenH_;
+        const float sw = (float)worldW_;
+        const float sh = (float)worldH_;
+        if (sleepingEnabled_)
+            activity_.wake(mouseX, mouseY, radius, clusters_, sleepFrames_);
         for (auto& c : clusters_)
             c.applyMouseForce(mouseX, mouseY, strength, radius, sw, sh);
     }
 
     // ── Render ────────────────────────────────────────────────────────────
     void draw(SDL_Renderer* renderer) {
-        const float sw            = (float)screenW_;
-        const float sh            = (float)screenH_;
-        const int   particleRadius = std::max(1, (int)particleSize_);
+        const float sw            = (float)worldW_;
+        const float sh            = (float)worldH_;
+        const int   particleRadius = std::max(1, (int)(particleSize_ * camera_.zoom));
+        const bool  blended        = swapBlend();
 
         // Connections underneath particles
         if (showConnections_) {
+            PROFILE_ZONE("Draw connections");
+            lines_.clear();
+            linkedClusters_ = 0;
+            for (const auto& c : clusters_) {
+                if (c.hasLinks(connectionRadius_, maxConnections_)) ++linkedClusters_;
+                c.drawConnections(lines_, sw, sh,
+                                  connectionRadius_, maxConnections_, camera_);
+            }
             SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
-            for (const auto& c : clusters_)
-                c.drawConnections(renderer, sw, sh,
-                                  connectionRadius_, maxConnections_);
+            lines_.flush(renderer);
             SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
         }
 
-        for (const auto& c : clusters_)
-            c.draw(renderer, particleRadius);
+        {
+            PROFILE_ZONE("Draw particles");
+            if (renderMode_ == RenderMode::Sprites) {
+                circles_.clear();
+                for (const auto& c : clusters_)
+                    c.draw(circles_, particleRadius, camera_);
+                circles_.flush(renderer);
+            } else {
+                renderLayers_.clear();
+                for (const auto& c : clusters_) {
+                    const Color& col = c.getColor();
+                    renderLayers_.push_back({ c.posX.data(), c.posY.data(), c.size(),
+                                              col.r, col.g, col.b, col.a });
+                }
+                const int layerCount = (int)renderLayers_.size();
+                if (renderMode_ == RenderMode::Splat) {
+                    splatter_.rasterize(renderLayers_.data(), layerCount, particleRadius, camera_);
+                    splatter_.present(renderer);
+                } else {
+                    density_.accumulate(renderLayers_.data(), layerCount, camera_, densityCellSize_);
+                    density_.colorize(renderLayers_.data(), densityColoring_);
+                    density_.present(renderer);
+                }
+            }
+        }
+
+        if (trails_.getTracks() > 0) {
+            PROFILE_ZONE("Draw trails");
+            lines_.clear();
+            trails_.draw(lines_,
+                [&](float x, float y, float& sx, float& sy) {
+                    sx = camera_.worldToScreenX(x);
+                    sy = camera_.worldToScreenY(y);
+                },
+                [&](int t) {
+                    const Color& c = clusters_[clusterOf(trails_.source(t))].getColor();
+                    return CircleBatch::ToFColor(c.r, c.g, c.b, 255);
+                },
+                0.5f * std::min(sw, sh));
+            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+            lines_.flush(renderer);
+            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+        }
 
         SDL_SetRenderDrawColor(renderer, 100, 100, 100, 255);
         SDL_FRect boundary = {
-            marginX_, marginY_,
-            (float)screenW_ - 2.f * marginX_,
-            (float)screenH_ - 2.f * marginY_
+            camera_.worldToScreenX(marginX_),
+            camera_.worldToScreenY(marginY_),
+            (sw - 2.f * marginX_) * camera_.zoom,
+            (sh - 2.f * marginY_) * camera_.zoom
         };
         SDL_RenderRect(renderer, &boundary);
+        if (blended) swapBlend(false);   // restore the simulated positions
+    }
+
+    // Saves the current positions as the start of the next interpolation;
+    // call before the steps of each fixed tick
+    void storePreviousPositions() {
+        prevX_.resize(clusters_.size());
+        prevY_.resize(clusters_.size());
+        for (size_t c = 0; c < clusters_.size(); ++c) {
+            prevX_[c] = clusters_[c].posX;
+            prevY_[c] = clusters_[c].posY;
+        }
     }
 
     // ── Statistics / accessors ────────────────────────────────────────────
@@ -339,11 +603,84 @@ public:
     int getTotalParticles() const { return totalParticles_; }
     int getRuleCount()      const { return (int)rules_.size(); }
 
+    // Per-stage wall time of the last update()
+    const StageTimings& getStageTimings() const { return timings_; }
+
     Cluster&       getCluster(int i)       { return clusters_[i]; }
     const Cluster& getCluster(int i) const { return clusters_[i]; }
 
     Rule&       getRule(int i)       { return rules_[i]; }
     const Rule& getRule(int i) const { return rules_[i]; }
+
+private:
+    // Fills blendX_/blendY_ with the positions at interpolation_ and swaps
+    // them with the clusters' own, so every render path draws the blend.
+    // Moves longer than half the world are wrap-arounds and are not blended.
+    // swapBlend(false) swaps the simulated positions back.
+    bool swapBlend(bool fill = true) {
+        if (!fill) {
+            for (size_t c = 0; c < clusters_.size(); ++c) {
+                std::swap(clusters_[c].posX, blendX_[c]);
+                std::swap(clusters_[c].posY, blendY_[c]);
+            }
+            return false;
+        }
+        if (interpolation_ >= 1.f || prevX_.size() != clusters_.size()) return false;
+
+        PROFILE_ZONE("Interpolate");
+        const float a  = interpolation_;
+        const float jx = 0.5f * (float)worldW_;
+        const float jy = 0.5f * (float)worldH_;
+        blendX_.resize(clusters_.size());
+        blendY_.resize(clusters_.size());
+        for (size_t c = 0; c < clusters_.size(); ++c) {
+            const Cluster& cl = clusters_[c];
+            const int n = cl.size();
+            blendX_[c].resize(n);
+            blendY_[c].resize(n);
+            if ((int)prevX_[c].size() != n) {
+                std::copy(cl.posX.begin(), cl.posX.end(), blendX_[c].begin());
+                std::copy(cl.posY.begin(), cl.posY.end(), blendY_[c].begin());
+                continue;
+            }
+            const float* px = prevX_[c].data();
+            const float* py = prevY_[c].data();
+            float*       bx = blendX_[c].data();
+            float*       by = blendY_[c].data();
+            #pragma omp parallel for schedule(static)
+            for (int i = 0; i < n; ++i) {
+                const float dx = cl.posX[i] - px[i];
+                const float dy = cl.posY[i] - py[i];
+                bx[i] = std::fabs(dx) < jx ? px[i] + dx * a : cl.posX[i];
+                by[i] = std::fabs(dy) < jy ? py[i] + dy * a : cl.posY[i];
+            }
+        }
+        for (size_t c = 0; c < clusters_.size(); ++c) {
+            std::swap(clusters_[c].posX, blendX_[c]);
+            std::swap(clusters_[c].posY, blendY_[c]);
+        }
+        return true;
+    }
+
+    void recordTrails() {
+        clusterStarts_.clear();
+        int start = 0;
+        for (const auto& c : clusters_) {
+            clusterStarts_.push_back(start);
+            start += c.size();
+        }
+        trails_.record(start, [&](int g, float& x, float& y) {
+            const int c = clusterOf(g);
+            x = clusters_[c].posX[g - clusterStarts_[c]];
+            y = clusters_[c].posY[g - clusterStarts_[c]];
+        });
+    }
+
+    // Cluster holding global particle index g, as of the last recordTrails()
+    int clusterOf(int g) const {
+        const auto it = std::upper_bound(clusterStarts_.begin(), clusterStarts_.end(), g);
+        return (int)(it - clusterStarts_.begin()) - 1;
+    }
 };
 
 } // namespace ParticleLife
\ No newline at end of file
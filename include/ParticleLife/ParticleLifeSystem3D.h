@@ -0,0 +1,259 @@
+#pragma once
+
+#include "Cluster3D.h"
+#include "ParticleLifeSystem.h"
+#include "Core/Camera3D.h"
+#include "Core/CircleBatch.h"
+#include <SDL3/SDL.h>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+namespace ParticleLife {
+
+/**
+ * Particle Life in a 3D box, rendered through the SDL renderer with an
+ * orthographic or perspective Camera3D.  Shares Color / Rule / BoundaryMode
+ * with the 2D system.
+ */
+class ParticleLifeSystem3D {
+private:
+    std::vector<Cluster3D> clusters_;
+    std::vector<Rule>      rules_;
+
+    // Global physics
+    float        viscosity_    = 0.5f;
+    float        worldGravity_ = 0.0f;
+    float        particleSize_ = 6.0f;   // world units; projected size depends on depth
+    BoundaryMode boundaryMode_ = BoundaryMode::Wrapping;
+
+    // World box
+    float worldW_ = 1500.f;
+    float worldH_ = 1500.f;
+    float worldD_ = 1500.f;
+
+    // Rendering
+    Camera3D camera_;
+    bool     depthSort_ = true;
+    bool     depthFade_ = true;
+    bool     showBox_   = true;
+
+    int totalParticles_ = 0;
+
+    // Projected particle, one per visible particle per frame
+    struct Splat {
+        float depth;
+        float sx, sy;
+        int   radius;
+        int   cluster;
+    };
+    std::vector<Splat> splats_;
+    CircleBatch        circles_;   // splats in painter's order, one draw call
+
+public:
+    ParticleLifeSystem3D() {
+        camera_.targetX = worldW_ * 0.5f;
+        camera_.targetY = worldH_ * 0.5f;
+        camera_.targetZ = worldD_ * 0.5f;
+        camera_.distance = 2.2f * worldW_;
+    }
+
+    void setScreenSize(int w, int h) { camera_.setViewport((float)w, (float)h); }
+
+    void setWorldSize(float w, float h, float d) {
+        worldW_ = std::max(w, 10.f);
+        worldH_ = std::max(h, 10.f);
+        worldD_ = std::max(d, 10.f);
+        camera_.targetX = worldW_ * 0.5f;
+        camera_.targetY = worldH_ * 0.5f;
+        camera_.targetZ = worldD_ * 0.5f;
+        resetPositions();
+    }
+
+    // ── Getters / Setters ─────────────────────────────────────────────────
+    float        getViscosity()    const { return viscosity_;    }
+    float        getWorldGravity() const { return worldGravity_; }
+    float        getParticleSize() const { return particleSize_; }
+    BoundaryMode getBoundaryMode() const { return boundaryMode_; }
+    float        getWorldWidth()   const { return worldW_; }
+    float        getWorldHeight()  const { return worldH_; }
+    float        getWorldDepth()   const { return worldD_; }
+    bool         getDepthSort()    const { return depthSort_; }
+    bool         getDepthFade()    const { return depthFade_; }
+    bool         getShowBox()      const { return showBox_;   }
+
+    void setViscosity   (float v)        { viscosity_    = v; }
+    void setWorldGravity(float g)        { worldGravity_ = g; }
+    void setParticleSize(float s)        { particleSize_ = s; }
+    void setBoundaryMode(BoundaryMode m) { boundaryMode_ = m; }
+    void setDepthSort   (bool b)         { depthSort_    = b; }
+    void setDepthFade   (bool b)         { depthFade_    = b; }
+    void setShowBox     (bool b)         { showBox_      = b; }
+
+    Camera3D&       getCamera()       { return camera_; }
+    const Camera3D& getCamera() const { return camera_; }
+
+    // ── Clusters / Rules ──────────────────────────────────────────────────
+    int addCluster(int count, const Color& color = Color::Random()) {
+        Cluster3D c(count, color);
+        c.resize(count, 0.f, 0.f, 0.f, worldW_, worldH_, worldD_);
+        clusters_.push_back(std::move(c));
+        totalParticles_ += count;
+        return (int)clusters_.size() - 1;
+    }
+
+    void resizeCluster(int idx, int newSize) {
+        if (idx < 0 || idx >= (int)clusters_.size()) return;
+        totalParticles_ -= clusters_[idx].size();
+        clusters_[idx].resize(newSize, 0.f, 0.f, 0.f, worldW_, worldH_, worldD_);
+        totalParticles_ += newSize;
+    }
+
+    void addRule(int a, int b, float gravity, float radius = 200.0f) {
+        rules_.emplace_back(a, b, gravity, radius);
+    }
+
+    void clearRules() { rules_.clear(); }
+
+    void clear() {
+        clusters_.clear();
+        rules_.clear();
+        totalParticles_ = 0;
+    }
+
+    void setupDefault4Clusters(int perCluster = 1000) {
+        clear();
+        addCluster(perCluster, Color::Green());
+        addCluster(perCluster, Color::Red());
+        addCluster(perCluster, Color::White());
+        addCluster(perCluster, Color::Yellow());
+        generateRandomRules(-100.f, 100.f, 20.f, 200.f);
+    }
+
+    void generateRandomRules(float minG = -100.f, float maxG = 100.f,
+                             float minR =   20.f, float maxR = 200.f)
+    {
+        clearRules();
+        auto& gen = Random::Engine();
+        std::uniform_real_distribution<float> dG(minG, maxG);
+        std::uniform_real_distribution<float> dR(minR, maxR);
+        for (int i = 0; i < (int)clusters_.size(); ++i)
+            for (int j = 0; j < (int)clusters_.size(); ++j)
+                addRule(i, j, dG(gen), dR(gen));
+    }
+
+    void resetPositions() {
+        for (int i = 0; i < (int)clusters_.size(); ++i)
+            resizeCluster(i, clusters_[i].size());
+    }
+
+    // ── Update ────────────────────────────────────────────────────────────
+    void update() {
+        const bool wrap = boundaryMode_ == BoundaryMode::Wrapping;
+        ALLOC_SCOPE("ParticleLife 3D");
+
+        for (const auto& rule : rules_) {
+            if (rule.clusterA < (int)clusters_.size() &&
+                rule.clusterB < (int)clusters_.size())
+            {
+                PROFILE_ZONE("Rule 3D");
+                clusters_[rule.clusterA].rule(
+                    clusters_[rule.clusterB],
+                    rule.gravity, rule.radius,
+                    viscosity_, worldGravity_,
+                    worldW_, worldH_, worldD_,
+                    wrap);
+            }
+        }
+
+        for (auto& c : clusters_) {
+            if (wrap) c.applyBoundariesWrapping(worldW_, worldH_, worldD_);
+            else      c.applyBoundariesClamping(worldW_, worldH_, worldD_);
+        }
+    }
+
+    // ── Render ────────────────────────────────────────────────────────────
+    void draw(SDL_Renderer* renderer) {
+        PROFILE_ZONE("Draw 3D");
+        camera_.update();
+
+        if (showBox_) drawBox(renderer);
+
+        // Project every particle; cull those behind the camera or off screen
+        splats_.clear();
+        splats_.reserve(totalParticles_);
+        float minDepth =  1e30f, maxDepth = -1e30f;
+        for (int c = 0; c < (int)clusters_.size(); ++c) {
+            const Cluster3D& cl = clusters_[c];
+            for (int i = 0, n = cl.size(); i < n; ++i) {
+                Splat s;
+                float scale;
+                if (!camera_.project(cl.posX[i], cl.posY[i], cl.posZ[i],
+                                     s.sx, s.sy, s.depth, scale))
+                    continue;
+                s.radius  = std::clamp((int)(particleSize_ * scale), 0, 64);
+                if (s.sx + s.radius < 0.f || s.sx - s.radius > camera_.viewW ||
+                    s.sy + s.radius < 0.f || s.sy - s.radius > camera_.viewH)
+                    continue;
+                s.cluster = c;
+                minDepth = std::min(minDepth, s.depth);
+                maxDepth = std::max(maxDepth, s.depth);
+                splats_.push_back(s);
+            }
+        }
+
+        // Painter's algorithm: far particles first
+        if (depthSort_)
+            std::sort(splats_.begin(), splats_.end(),
+                      [](const Splat& a, const Splat& b) { return a.depth > b.depth; });
+
+        const float depthRange = std::max(maxDepth - minDepth, 1e-3f);
+        circles_.clear();
+        for (const Splat& s : splats_) {
+            const Color& col = clusters_[s.cluster].getColor();
+            // Far particles fade to 35% brightness to convey depth
+            const float k = depthFade_
+                ? 1.f - 0.65f * (s.depth - minDepth) / depthRange
+                : 1.f;
+            circles_.add(s.sx, s.sy, s.radius,
+                         CircleBatch::ToFColor((Uint8)(col.r * k), (Uint8)(col.g * k),
+                                               (Uint8)(col.b * k), col.a));
+        }
+        circles_.flush(renderer);
+    }
+
+    void drawBox(SDL_Renderer* renderer) const {
+        const float W = worldW_, H = worldH_, D = worldD_;
+        const float corners[8][3] = {
+            {0, 0, 0}, {W, 0, 0}, {W, H, 0}, {0, H, 0},
+            {0, 0, D}, {W, 0, D}, {W, H, D}, {0, H, D},
+        };
+        static const int edges[12][2] = {
+            {0,1},{1,2},{2,3},{3,0}, {4,5},{5,6},{6,7},{7,4}, {0,4},{1,5},{2,6},{3,7},
+        };
+        float sx[8], sy[8], depth, scale;
+        bool  ok[8];
+        for (int k = 0; k < 8; ++k)
+            ok[k] = camera_.project(corners[k][0], corners[k][1], corners[k][2],
+                                    sx[k], sy[k], depth, scale);
+
+        SDL_SetRenderDrawColor(renderer, 100, 100, 100, 255);
+        for (const auto& e : edges)
+            if (ok[e[0]] && ok[e[1]])
+                SDL_RenderLine(renderer, sx[e[0]], sy[e[0]], sx[e[1]], sy[e[1]]);
+    }
+
+    // ── Statistics / accessors ────────────────────────────────────────────
+    int getClusterCount()   const { return (int)clusters_.size(); }
+    int getTotalParticles() const { return totalParticles_; }
+    int getRuleCount()      const { return (int)rules_.size(); }
+    int getVisibleCount()   const { return (int)splats_.size(); }
+
+    Cluster3D&       getCluster(int i)       { return clusters_[i]; }
+    const Cluster3D& getCluster(int i) const { return clusters_[i]; }
+
+    Rule&       getRule(int i)       { return rules_[i]; }
+    const Rule& getRule(int i) const { return rules_[i]; }
+};
+
+} // namespace ParticleLife
@@ -0,0 +1,185 @@
+#pragma once
+
+#include "Core/SpatialGrid.h"
+#include "Core/Profiler.h"
+
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace ParticleLife {
+
+/**
+ * The force kernel behind Cluster::rule() and Cluster3D::rule(), written once
+ * for D = 2 and D = 3.
+ *
+ * ApplyRule() bins the source cluster into its grid, then for each target
+ * particle (in parallel) visits the 3^D neighbouring cells, sums unit vectors
+ * to every source particle within radius, and integrates velocity and
+ * position in place. Wrapped worlds use the shortest toroidal offset. Axis 1
+ * (y) also gets the constant world gravity.
+ *
+ * Positions and velocities are SoA: pos[a] is the array for axis a. When
+ * the source is the target cluster, opos aliases pos, as in the original
+ * per-cluster loops.
+ *
+ * Inside an enclosing parallel region (Ensemble steps one world per thread)
+ * the loop runs serially on the calling thread instead of opening a nested
+ * team.
+ */
+
+// Grid layout and boundary of one rule pass, per axis
+template <int D>
+struct RuleSpace {
+    float extent[D];         // grid span from origin when not wrapping
+    float period[D];         // toroidal world size when wrapping
+    float origin[D];         // grid origin (the world minimum)
+    bool  wrapping = false;
+};
+
+// Force law parameters, as given to Cluster::rule()
+struct RuleForce {
+    float gravity;
+    float radius;
+    float viscosity;
+    float worldGravity;
+};
+
+// Optional same-cluster link output (see Cluster::requestLinks()). Records
+// for each particle i up to maxPerParticle partners j > i closer than
+// sqrt(r2); pairs that are neighbours only across the wrap seam are skipped.
+// Sleeping particles keep their slots unless includeSleeping is set; they are
+// then traversed for links only, without forces or integration.
+struct RuleLinks {
+    float    r2;
+    int      maxPerParticle;
+    int*     slots;          // [i * maxPerParticle + k]
+    uint8_t* count;          // used slots per particle
+    bool     includeSleeping;
+};
+
+// ── Grid adapters ─────────────────────────────────────────────────────────
+inline void BuildRuleGrid(SpatialGrid& grid, const float* const* p, int m,
+                          float cs, const int* cells, const float* origin)
+{
+    grid.build(p[0], p[1], m, cs, cells[0], cells[1], origin[0], origin[1]);
+}
+
+inline void BuildRuleGrid(SpatialGrid3D& grid, const float* const* p, int m,
+                          float cs, const int* cells, const float* origin)
+{
+    grid.build(p[0], p[1], p[2], m, cs, cells[0], cells[1], cells[2],
+               origin[0], origin[1], origin[2]);
+}
+
+template<typename Func>
+void ForEachRuleNeighbor(const SpatialGrid& grid, const int* c, const int* cells,
+                         bool wrapping, const Func& func)
+{
+    if (wrapping) grid.forEachNeighborWrapped(c[0], c[1], cells[0], cells[1], func);
+    else          grid.forEachNeighbor       (c[0], c[1], cells[0], cells[1], func);
+}
+
+template<typename Func>
+void ForEachRuleNeighbor(const SpatialGrid3D& grid, const int* c, const int*,
+                         bool wrapping, const Func& func)
+{
+    if (wrapping) grid.forEachNeighborWrapped(c[0], c[1], c[2], func);
+    else          grid.forEachNeighbor       (c[0], c[1], c[2], func);
+}
+
+// ── Kernel ────────────────────────────────────────────────────────────────
+// sleeping (may be null) skips flagged target particles (links aside, see
+// RuleLinks::includeSleeping).
+template <int D, class Grid>
+void ApplyRule(Grid& grid,
+               float* const* pos, float* const* vel, int n,
+               const float* const* opos, int m,
+               const RuleSpace<D>& space, const RuleForce& force,
+               const uint8_t* sleeping = nullptr,
+               const RuleLinks* links  = nullptr,
+               const char* zone        = "Rule worker")
+{
+    if (n == 0 || m == 0) return;
+
+    const float g    = force.gravity / -100.0f;
+    const float r2   = force.radius * force.radius;
+    const float damp = 1.0f - force.viscosity;
+    const float cs   = std::max(force.radius, 1.0f);
+    const bool  wrapping = space.wrapping;
+
+    // Wrapped grids cover the world exactly, so forEachNeighborWrapped joins
+    // opposite edges. Their cell count is rounded down: the clamp folds the
+    // remainder into the last cell, so every cell spans >= cs and pairs
+    // across the seam stay in adjacent cells (a partial last cell would
+    // leave them two cells apart).
+    int   cells[D];
+    float half[D];
+    for (int a = 0; a < D; ++a) {
+        cells[a] = wrapping ? std::max(1, (int)(space.period[a] / cs))
+                            : std::max(1, (int)(space.extent[a] / cs) + 2);
+        half[a]  = space.period[a] * 0.5f;
+    }
+
+    BuildRuleGrid(grid, opos, m, cs, cells, space.origin);
+
+    const int maxLinks = links ? links->maxPerParticle : 0;
+
+    #pragma omp parallel if(!omp_in_parallel())
+    {
+        PROFILE_ZONE(zone);
+        #pragma omp for schedule(static)
+        for (int i = 0; i < n; ++i) {
+            const bool asleep = sleeping && sleeping[i];
+            if (asleep && !(links && links->includeSleeping)) continue;
+
+            float p[D], f[D];
+            int   c[D];
+            for (int a = 0; a < D; ++a) {
+                p[a] = pos[a][i];
+                f[a] = 0.f;
+                c[a] = std::clamp((int)((p[a] - space.origin[a]) / cs), 0, cells[a] - 1);
+            }
+
+            int  linkCount = 0;
+            int* mySlots   = links ? links->slots + (size_t)i * maxLinks : nullptr;
+
+            auto process = [&](int j) {
+                float d[D];
+                float d2      = 0.f;
+                bool  shifted = false;
+                for (int a = 0; a < D; ++a) {
+                    d[a] = p[a] - opos[a][j];
+                    if (wrapping) {
+                        // Shortest-path (toroidal) offset
+                        if      (d[a] >  half[a]) { d[a] -= space.period[a]; shifted = true; }
+                        else if (d[a] < -half[a]) { d[a] += space.period[a]; shifted = true; }
+                    }
+                    d2 += d[a] * d[a];
+                }
+                if (d2 > 0.f && d2 < r2) {
+                    const float inv_d = 1.f / sqrtf(d2);
+                    for (int a = 0; a < D; ++a) f[a] += d[a] * inv_d;
+
+                    if (links && j > i && linkCount < maxLinks && d2 < links->r2 && !shifted)
+                        mySlots[linkCount++] = j;
+                }
+            };
+
+            ForEachRuleNeighbor(grid, c, cells, wrapping, process);
+            if (links) links->count[i] = (uint8_t)linkCount;
+            if (asleep) continue;   // links only
+
+            for (int a = 0; a < D; ++a) {
+                vel[a][i] = (vel[a][i] + f[a] * g) * damp + (a == 1 ? force.worldGravity : 0.f);
+                pos[a][i] += vel[a][i];
+            }
+        }
+    }
+}
+
+} // namespace ParticleLife
@@ -16,6 +16,9 @@
 #endif
 
 #include "AudioCPPN/AudioBands.h"
+#include "Core/Profiler.h"
+#include "Core/AllocTracker.h"
+#include "Core/FrameArena.h"
 #include <unsupported/Eigen/FFT>
 #include <filesystem>
 #include <algorithm>
@@ -175,6 +178,11 @@ double AudioBands::getPositionSec() const {
 
 void AudioBands::audioCallback(ma_device* dev, void* out,
                                 const void* /*in*/, uint32_t frameCount) {
+    // Name the device thread once so it shows up labelled in traces
+    static thread_local bool named = false;
+    if (!named) { Profiler::SetThreadName("audio"); named = true; }
+    PROFILE_ZONE("Audio callback");
+
     auto* self    = static_cast<AudioBands*>(dev->pUserData);
     auto* outF    = static_cast<float*>(out);
     int   channels = (int)dev->playback.channels;
@@ -208,6 +216,8 @@ void AudioBands::onAudioData(const float* pcm, uint32_t frameCount, int channels
 // ── Main-thread DSP ───────────────────────────────────────────────────────────
 
 bool AudioBands::update() {
+    PROFILE_ZONE("Audio FFT");
+    ALLOC_SCOPE("Audio bands");
     if (!ringBuffer_.readLatest(pcmScratch_.data(), FFT_SIZE))
         return false;
 
@@ -255,10 +265,12 @@ float AudioBands::medianUpdate(std::deque<float>& hist, float value, int window)
     if ((int)hist.size() > window)
         hist.pop_front();
 
-    // Compute median
-    std::vector<float> sorted(hist.begin(), hist.end());
-    std::sort(sorted.begin(), sorted.end());
-    float med = sorted[sorted.size() / 2];
+    // Compute median (frame scratch, partial selection)
+    const size_t n = hist.size();
+    float* sorted = FrameArena::Local().allocArray<float>(n);
+    std::copy(hist.begin(), hist.end(), sorted);
+    std::nth_element(sorted, sorted + n / 2, sorted + n);
+    float med = sorted[n / 2];
 
     // Normalise: divide by median (floor at epsilon)
     static constexpr float EPS = 1e-6f;
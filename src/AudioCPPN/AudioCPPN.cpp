@@ -1,5 +1,6 @@
 #include "AudioCPPN/AudioCPPN.h"
 #include "ParticleLife/ParticleLifeSystem.h"
+#include "Core/FrameArena.h"
 
 #include <imgui.h>
 #include <implot.h>
@@ -88,10 +89,12 @@ static float mapRange(float t, float lo, float hi) {
 void AudioCPPN::runMLP() {
     int nr = (int)lastGravities_.size();
     const auto& b = bands_.getBands();
-    Eigen::VectorXf input(NUM_BANDS);
+    FrameArena& arena = FrameArena::Local();
+    Eigen::Map<Eigen::VectorXf> input(arena.allocArray<float>(NUM_BANDS), NUM_BANDS);
     for (int i = 0; i < NUM_BANDS; ++i)
         input[i] = b[i] * bandWeights_[i];
-    Eigen::VectorXf out = mlp_.forward(input);
+    float* out = arena.allocArray<float>(mlp_.getOutputSize());
+    mlp_.forward(input, out);
     for (int i = 0; i < nr; ++i) {
         lastGravities_[i] = mapRange(out[i],      gravityMin_, gravityMax_);
         lastRadii_[i]     = mapRange(out[i + nr], radiusMin_,  radiusMax_);
@@ -126,13 +129,15 @@ void AudioCPPN::runBandMLP(ParticleLife::ParticleLifeSystem* system) {
     int nc = cachedClusterCount_;
     int nr = system->getRuleCount();
 
-    Eigen::VectorXf input(1);
+    FrameArena& arena = FrameArena::Local();
+    Eigen::Map<Eigen::VectorXf> input(arena.allocArray<float>(1), 1);
+    float* out = arena.allocArray<float>(bandMlp_.getOutputSize());
     for (int i = 0; i < nc && i < (int)clusterBand_.size(); ++i) {
         // Single-value input: this cluster's band energy, normalised by sensitivity
         input[0] = std::clamp(
             (b[clusterBand_[i]] * bandWeights_[clusterBand_[i]] - 1.f) * bcSensitivity_,
             -1.f, 1.f);
-        Eigen::VectorXf out = bandMlp_.forward(input);  // nc*2 values in (-1,1)
+        bandMlp_.forward(input, out);  // nc*2 values in (-1,1)
 
         // Write outputs to every rule whose source is cluster i
         for (int k = 0; k < nr && k < (int)lastGravities_.size(); ++k) {
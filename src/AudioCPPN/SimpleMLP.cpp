@@ -1,4 +1,7 @@
 #include "AudioCPPN/SimpleMLP.h"
+#include "Core/Profiler.h"
+#include "Core/AllocTracker.h"
+#include "Core/FrameArena.h"
 #include <stdexcept>
 
 namespace AudioCPPN {
@@ -57,10 +60,32 @@ void SimpleMLP::setWeightsFlat(const std::vector<float>& flat) {
 }
 
 Eigen::VectorXf SimpleMLP::forward(const Eigen::VectorXf& x) const {
-    Eigen::VectorXf h = (weights_[0] * x).array().tanh();
-    for (int l = 1; l < (int)weights_.size(); ++l)
-        h = (weights_[l] * h).array().tanh();
-    return h;
+    Eigen::VectorXf out(outputSize_);
+    forward(x, out.data());
+    return out;
+}
+
+void SimpleMLP::forward(const Eigen::Ref<const Eigen::VectorXf>& x, float* output) const {
+    PROFILE_ZONE("MLP forward");
+    ALLOC_SCOPE("MLP");
+    using Vec = Eigen::Map<Eigen::VectorXf>;
+
+    // Ping-pong hidden activations in frame scratch; the last layer writes
+    // straight into `output`. noalias() keeps the products temporary-free.
+    FrameArena& arena = FrameArena::Local();
+    float* bufA = arena.allocArray<float>(hiddenSize_);
+    float* bufB = arena.allocArray<float>(hiddenSize_);
+
+    const int last = (int)weights_.size() - 1;
+    const float* src = nullptr;
+    for (int l = 0; l <= last; ++l) {
+        float* dstPtr = (l == last) ? output : (l % 2 == 0 ? bufA : bufB);
+        Vec dst(dstPtr, weights_[l].rows());
+        if (l == 0) dst.noalias() = weights_[0] * x;
+        else        dst.noalias() = weights_[l] * Eigen::Map<const Eigen::VectorXf>(src, weights_[l].cols());
+        dst = dst.array().tanh();
+        src = dstPtr;
+    }
 }
 
 } // namespace AudioCPPN
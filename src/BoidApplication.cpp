@@ -14,6 +14,7 @@ private:
     // Simulation state
     int boidCount = 200;
     bool paused = false;
+    bool filledBoids = false;
     bool showDirection = false;
     bool showSteering = false;
     
@@ -21,30 +22,31 @@ public:
     // Called once at startup
     void OnStart() override {
         Debug::Log("Boids simulation starting...");
+        const ApplicationConfig& cfg = GetConfig();
+        if (!cfg.presetPath.empty() &&
+            !boidSystem.loadFromFile(cfg.presetPath, boidCount))
+            Debug::LogError("Failed to load preset: ", cfg.presetPath);
+        if (cfg.particleCount > 0) boidCount = cfg.particleCount;
         boidSystem.generate(boidCount, GetScreenWidth(), GetScreenHeight());
     }
     
-    // Called every frame
-    void OnUpdate(float deltaTime) override {
+    // Called at the fixed simulation rate
+    void OnFixedUpdate(float fixedDeltaTime) override {
         // Update boids if not paused
         if (!paused) {
-            boidSystem.update(deltaTime, GetScreenWidth(), GetScreenHeight());
+            boidSystem.update(fixedDeltaTime, GetScreenWidth(), GetScreenHeight());
         }
     }
     
     // Called every frame for rendering
     void OnRender() override {
-        // Draw boids
-        boidSystem.draw(GetRenderer());
-        
-        // Draw optional visualizations
-        if (showDirection) {
-            boidSystem.drawDirectionVectors(GetRenderer());
-        }
-        
-        if (showSteering) {
-            boidSystem.drawSteeringVectors(GetRenderer());
-        }
+        // Bodies and optional visualizations in one batch
+        BoidDrawOptions draw;
+        draw.filled    = filledBoids;
+        draw.direction = showDirection;
+        draw.steering  = showSteering;
+        draw.interpolation = paused ? 1.f : GetInterpolationAlpha();
+        boidSystem.draw(GetRenderer(), draw);
     }
     
     // Called every frame for GUI
@@ -85,8 +87,10 @@ public:
         
         GUI::Separator();
         GUI::Text("Visualization");
+        GUI::Checkbox("Filled Triangles", &filledBoids);
         GUI::Checkbox("Show Direction Vector", &showDirection);
         GUI::Checkbox("Show Steering Vector", &showSteering);
+        TrailControls(&boidSystem.getTrailHistory());
         
         GUI::Separator();
         
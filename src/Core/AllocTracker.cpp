@@ -0,0 +1,239 @@
+#include "Core/AllocTracker.h"
+
+#include <imgui.h>
+
+#include <atomic>
+#include <mutex>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <new>
+#include <algorithm>
+
+namespace {
+
+using Counters = AllocTracker::Counters;
+
+// Constant-initialised so allocations made before main() are safe to record
+struct Tag {
+    const char*           name = nullptr;
+    std::atomic<uint64_t> allocs{ 0 };
+    std::atomic<uint64_t> bytes{ 0 };
+    std::atomic<uint64_t> frees{ 0 };
+};
+
+Tag              tags[AllocTracker::MaxTags];
+std::atomic<int> tagCount{ 1 };        // 0 = "other"
+std::mutex       tagMutex;             // registration only
+
+thread_local int currentTag = 0;
+
+// ── Frame bookkeeping (main thread) ───────────────────────────────────────
+struct TagStats {
+    Counters prev;             // running totals at the previous EndFrame
+    Counters last;             // last frame
+    Counters steadySum;        // sum over frames after the warmup
+    uint64_t steadyMaxAllocs = 0;
+};
+
+TagStats stats[AllocTracker::MaxTags];
+uint64_t frameCount  = 0;
+uint64_t steadyCount = 0;
+
+Counters totals(int tag) {
+    const Tag& t = tags[tag];
+    return { t.allocs.load(std::memory_order_relaxed),
+             t.bytes.load(std::memory_order_relaxed),
+             t.frees.load(std::memory_order_relaxed) };
+}
+
+double perFrame(uint64_t sum) {
+    return steadyCount > 0 ? (double)sum / steadyCount : 0.0;
+}
+
+} // namespace
+
+// ── Tags ──────────────────────────────────────────────────────────────────
+int AllocTracker::RegisterTag(const char* name) {
+    std::lock_guard<std::mutex> lock(tagMutex);
+    const int count = tagCount.load(std::memory_order_relaxed);
+    for (int i = 1; i < count; ++i)
+        if (std::strcmp(tags[i].name, name) == 0) return i;
+    if (count == MaxTags) return 0;
+    tags[count].name = name;
+    tagCount.store(count + 1, std::memory_order_release);
+    return count;
+}
+
+int AllocTracker::SetThreadTag(int tag) {
+    const int prev = currentTag;
+    currentTag = tag;
+    return prev;
+}
+
+int AllocTracker::GetTagCount() {
+    return tagCount.load(std::memory_order_acquire);
+}
+
+const char* AllocTracker::GetTagName(int tag) {
+    return tag == 0 ? "other" : tags[tag].name;
+}
+
+AllocTracker::Counters AllocTracker::GetLastFrame(int tag) {
+    return stats[tag].last;
+}
+
+// ── Hooks side ────────────────────────────────────────────────────────────
+void AllocTracker::RecordAlloc(size_t bytes) {
+    Tag& t = tags[currentTag];
+    t.allocs.fetch_add(1, std::memory_order_relaxed);
+    t.bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void AllocTracker::RecordFree() {
+    tags[currentTag].frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+// ── Frame ─────────────────────────────────────────────────────────────────
+void AllocTracker::EndFrame() {
+    if (!IsCompiledIn()) return;
+
+    const bool steady = ++frameCount > (uint64_t)WarmupFrames;
+    if (steady) ++steadyCount;
+
+    const int count = GetTagCount();
+    for (int i = 0; i < count; ++i) {
+        TagStats& s   = stats[i];
+        const Counters now = totals(i);
+        s.last = { now.allocs - s.prev.allocs, now.bytes - s.prev.bytes, now.frees - s.prev.frees };
+        s.prev = now;
+        if (steady) {
+            s.steadySum.allocs += s.last.allocs;
+            s.steadySum.bytes  += s.last.bytes;
+            s.steadySum.frees  += s.last.frees;
+            s.steadyMaxAllocs   = std::max(s.steadyMaxAllocs, s.last.allocs);
+        }
+    }
+}
+
+void AllocTracker::PrintSummary() {
+    if (!IsCompiledIn() || steadyCount == 0) return;
+
+    std::printf("[AllocTracker] Allocations per frame over %llu frames (after %d warmup)\n",
+                (unsigned long long)steadyCount, WarmupFrames);
+    std::printf("  %-16s %12s %12s %12s %12s\n", "tag", "allocs/frame", "KB/frame", "frees/frame", "max allocs");
+    for (int i = 0; i < GetTagCount(); ++i) {
+        const TagStats& s = stats[i];
+        std::printf("  %-16s %12.2f %12.2f %12.2f %12llu\n", GetTagName(i),
+                    perFrame(s.steadySum.allocs), perFrame(s.steadySum.bytes) / 1024.0,
+                    perFrame(s.steadySum.frees), (unsigned long long)s.steadyMaxAllocs);
+    }
+}
+
+// ── Panel ─────────────────────────────────────────────────────────────────
+void AllocTracker::DrawPanel(bool* open) {
+    ImGui::SetNextWindowSize(ImVec2(520, 320), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Allocations", open)) {
+        ImGui::End();
+        return;
+    }
+
+    if (!IsCompiledIn()) {
+        ImGui::TextDisabled("Built with ENABLE_ALLOC_TRACKING=OFF.");
+        ImGui::End();
+        return;
+    }
+
+    uint64_t frameAllocs = 0;
+    for (int i = 0; i < GetTagCount(); ++i) frameAllocs += stats[i].last.allocs;
+    if (frameAllocs == 0)
+        ImGui::TextColored(ImVec4(0.3f, 1.f, 0.3f, 1.f), "0 allocations last frame");
+    else
+        ImGui::TextColored(ImVec4(1.f, 0.6f, 0.f, 1.f), "%llu allocations last frame",
+                           (unsigned long long)frameAllocs);
+
+    if (ImGui::BeginTable("##allocs", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
+                                         ImGuiTableFlags_SizingFixedFit))
+    {
+        ImGui::TableSetupColumn("Tag", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("allocs");
+        ImGui::TableSetupColumn("KB");
+        ImGui::TableSetupColumn("frees");
+        ImGui::TableSetupColumn("avg allocs");
+        ImGui::TableSetupColumn("max allocs");
+        ImGui::TableHeadersRow();
+
+        for (int i = 0; i < GetTagCount(); ++i) {
+            const TagStats& s = stats[i];
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0); ImGui::TextUnformatted(GetTagName(i));
+            ImGui::TableSetColumnIndex(1); ImGui::Text("%llu", (unsigned long long)s.last.allocs);
+            ImGui::TableSetColumnIndex(2); ImGui::Text("%.1f", s.last.bytes / 1024.0);
+            ImGui::TableSetColumnIndex(3); ImGui::Text("%llu", (unsigned long long)s.last.frees);
+            ImGui::TableSetColumnIndex(4); ImGui::Text("%.2f", perFrame(s.steadySum.allocs));
+            ImGui::TableSetColumnIndex(5); ImGui::Text("%llu", (unsigned long long)s.steadyMaxAllocs);
+        }
+        ImGui::EndTable();
+    }
+    ImGui::TextDisabled("Columns 1-3: last frame. avg/max: after %d warmup frames.", WarmupFrames);
+
+    ImGui::End();
+}
+
+// ── Global allocation hooks ───────────────────────────────────────────────
+#if ALIFE_ALLOC_TRACKING
+#if defined(__GLIBC__)
+
+// glibc: interpose the malloc family and forward to glibc's allocator.
+// operator new, Eigen and C libraries all allocate through these.
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void  __libc_free(void* ptr);
+
+void* malloc(size_t size) noexcept {
+    AllocTracker::RecordAlloc(size);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) noexcept {
+    AllocTracker::RecordAlloc(count * size);
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) noexcept {
+    AllocTracker::RecordAlloc(size);
+    return __libc_realloc(ptr, size);
+}
+
+void free(void* ptr) noexcept {
+    if (ptr) AllocTracker::RecordFree();
+    __libc_free(ptr);
+}
+} // extern "C"
+
+#else
+
+// Elsewhere: replace the global operator new/delete (nothrow and array forms
+// forward to these by default).
+void* operator new(std::size_t size) {
+    AllocTracker::RecordAlloc(size);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) { return ::operator new(size); }
+
+void operator delete(void* ptr) noexcept {
+    if (!ptr) return;
+    AllocTracker::RecordFree();
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept              { ::operator delete(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept   { ::operator delete(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { ::operator delete(ptr); }
+
+#endif
+#endif // ALIFE_ALLOC_TRACKING
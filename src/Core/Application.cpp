@@ -2,9 +2,18 @@
 #include "Core/Time.h"
 #include "Core/Input.h"
 #include "Core/GUI.h"
+#include "Core/Profiler.h"
+#include "Core/AllocTracker.h"
+#include "Core/FrameArena.h"
+#include "Core/TrailHistory.h"
 #include <iostream>
+#include <algorithm>
+#include <cstdio>
+#include <cmath>
 
 bool Application::Initialize(const ApplicationConfig& config) {
+    config_ = config;
+
     // Initialize SDL
     if (!SDL_Init(SDL_INIT_VIDEO)) {
         std::cerr << "[Application] SDL_Init Error: " << SDL_GetError() << std::endl;
@@ -34,6 +43,8 @@ bool Application::Initialize(const ApplicationConfig& config) {
         return false;
     }
 
+    SDL_SetRenderVSync(renderer, config.vsync ? 1 : 0);
+
     screenWidth = config.width;
     screenHeight = config.height;
 
@@ -41,6 +52,7 @@ bool Application::Initialize(const ApplicationConfig& config) {
     Time::Initialize();
     Input::Initialize();
     GUI::Initialize(window, renderer);
+    Profiler::SetThreadName("main");
 
     initialized = true;
     isRunning = true;
@@ -54,7 +66,15 @@ bool Application::Initialize(const ApplicationConfig& config) {
 }
 
 void Application::Run() {
+    int frame = 0;
+    if (config_.timingSummary && config_.maxFrames > 0)
+        frameMs_.reserve(config_.maxFrames);
+
     while (isRunning) {
+        // Last frame's scratch is dead: rewind every thread's arena
+        FrameArena::ResetAll();
+        StageClock clock(frameClock_);
+
         // Update time
         Time::Update();
         
@@ -73,6 +93,26 @@ void Application::Run() {
             if (event.type == SDL_EVENT_KEY_DOWN && event.key.scancode == SDL_SCANCODE_F9) {
                 RequestScreenshot();
             }
+
+            if (event.type == SDL_EVENT_KEY_DOWN && event.key.scancode == SDL_SCANCODE_F10) {
+                if (Profiler::IsTracing()) {
+                    const std::string path = Profiler::StopTrace();
+                    if (path.empty()) std::cerr << "[Application] Failed to write trace" << std::endl;
+                    else              std::cout << "[Application] Trace -> " << path << std::endl;
+                } else {
+                    Profiler::StartTrace();
+                    std::cout << "[Application] Trace capture started (F10 to stop)" << std::endl;
+                }
+            }
+
+            if (event.type == SDL_EVENT_KEY_DOWN && event.key.scancode == SDL_SCANCODE_F7) {
+                SetTrails(!trails_);
+            }
+
+            if (event.type == SDL_EVENT_KEY_DOWN && event.key.scancode == SDL_SCANCODE_F6) {
+                showProfiler_ = !showProfiler_;
+                if (showProfiler_) Profiler::SetEnabled(true);
+            }
             
             if (event.type == SDL_EVENT_QUIT) {
                 Quit();
@@ -84,34 +124,112 @@ void Application::Run() {
 
         // Update screen size
         UpdateScreenSize();
+        clock.lap("events");
+
+        // Fixed updates: one per Time::FixedDeltaTime() of scaled frame time.
+        // After maxFixedSteps the backlog is dropped, so a frame that ran
+        // long slows the simulation down instead of making the next one
+        // longer still. A fixed step of 0 means lockstep: exactly one
+        // update per frame with the frame's delta time.
+        {
+            PROFILE_ZONE("Fixed update");
+            ALLOC_SCOPE("Update");
+            const float fixedDt = Time::FixedDeltaTime();
+            fixedSteps_ = 0;
+            if (fixedDt <= 0.f) {
+                fixedAccumulator_ = 0.f;
+                OnFixedUpdate(Time::DeltaTime());
+                fixedSteps_ = 1;
+            } else {
+                fixedAccumulator_ += Time::DeltaTime();
+            }
+            while (fixedDt > 0.f && fixedAccumulator_ >= fixedDt) {
+                if (fixedSteps_ == std::max(1, config_.maxFixedSteps)) {
+                    fixedAccumulator_ = std::fmod(fixedAccumulator_, fixedDt);
+                    break;
+                }
+                OnFixedUpdate(fixedDt);
+                fixedAccumulator_ -= fixedDt;
+                ++fixedSteps_;
+            }
+        }
+        clock.lap("fixed");
         
         // User update
-        OnUpdate(Time::DeltaTime());
+        {
+            PROFILE_ZONE("Update");
+            ALLOC_SCOPE("Update");
+            OnUpdate(Time::DeltaTime());
+        }
+        clock.lap("update");
         
-        // Begin frame
-        SDL_SetRenderDrawColor(renderer, 20, 20, 30, 255);
-        SDL_RenderClear(renderer);
+        // GUI: built before rendering, so all GUI edits are in by the time
+        // OnRender runs (it may hand the next step to a worker thread);
+        // the draw data is submitted on top of the frame in Present.
+        {
+            PROFILE_ZONE("GUI");
+            ALLOC_SCOPE("GUI");
+            GUI::BeginFrame();
+            OnGUI();
+            if (showProfiler_) {
+                Profiler::DrawPanel(&showProfiler_);
+                if (AllocTracker::IsCompiledIn())
+                    AllocTracker::DrawPanel(&showProfiler_);
+            }
+        }
+        clock.lap("gui");
+
+        // Begin frame: clear, or fade the trail target and draw into it
+        const bool trails = trails_ && BeginTrails();
+        if (!trails) {
+            SDL_SetRenderDrawColor(renderer, 20, 20, 30, 255);
+            SDL_RenderClear(renderer);
+        }
         
         // User render
-        OnRender();
+        {
+            PROFILE_ZONE("Render");
+            ALLOC_SCOPE("Render");
+            OnRender();
+        }
+        if (trails) EndTrails();
 
-        // Record if started
-        recorder_.captureFrame(renderer);
+        // Record if started (before the GUI is drawn, so it stays out of the video)
+        {
+            PROFILE_ZONE("Capture");
+            recorder_.captureFrame(renderer);
+        }
 
         if (screenshotRequested_) {
             recorder_.screenshot(renderer);
             screenshotRequested_ = false;
         }
-        
-        // GUI
-        GUI::BeginFrame();
-        OnGUI();
-        GUI::EndFrame(renderer);
+        clock.lap("render");
         
         // Present
-        SDL_RenderPresent(renderer);
+        {
+            PROFILE_ZONE("Present");
+            ALLOC_SCOPE("Present");
+            GUI::EndFrame(renderer);
+            SDL_RenderPresent(renderer);
+        }
+        clock.lap("present");
+        frameTimings_ = frameClock_;
+        Profiler::EndFrame();
+        AllocTracker::EndFrame();
+
+        if (config_.timingSummary) {
+            frameTotals_.add(frameTimings_);
+            frameMs_.push_back((float)frameTimings_.total());
+        }
+
+        if (config_.maxFrames > 0 && ++frame >= config_.maxFrames)
+            Quit();
     }
 
+    if (config_.timingSummary)
+        PrintTimingSummary();
+
     // Launch ffmpeg if recording
     if (recorder_.isRecording())
         recorder_.toggle(screenWidth, screenHeight);
@@ -121,6 +239,101 @@ void Application::Run() {
     Shutdown();
 }
 
+void Application::PrintTimingSummary() const {
+    if (frameMs_.empty()) return;
+
+    std::vector<float> sorted = frameMs_;
+    std::sort(sorted.begin(), sorted.end());
+    auto pct = [&](double p) {
+        return sorted[std::min(sorted.size() - 1, (size_t)(p * (sorted.size() - 1) + 0.5))];
+    };
+
+    double sum = 0.0;
+    for (float ms : frameMs_) sum += ms;
+    const double avg = sum / frameMs_.size();
+
+    std::printf("[Application] Timing summary over %zu frames (vsync %s)\n",
+                frameMs_.size(), config_.vsync ? "on" : "off");
+    std::printf("  frame ms : avg %.3f  p50 %.3f  p95 %.3f  p99 %.3f  max %.3f  (%.1f fps)\n",
+                avg, pct(0.50), pct(0.95), pct(0.99), sorted.back(),
+                avg > 0.0 ? 1000.0 / avg : 0.0);
+    for (size_t k = 0; k < frameTotals_.names.size(); ++k)
+        std::printf("  %-8s : %.3f ms\n", frameTotals_.names[k].c_str(),
+                    frameTotals_.averageMs(k));
+    const FrameArena::Stats arena = FrameArena::GetStats();
+    std::printf("  arena    : high-water %.1f KB, capacity %.1f KB over %d thread arena(s)\n",
+                arena.highWater / 1024.0, arena.capacity / 1024.0, arena.arenas);
+    AllocTracker::PrintSummary();
+}
+
+void Application::SetTrails(bool on) {
+    trails_ = on;
+    if (!on && trailTarget_) {
+        SDL_DestroyTexture(trailTarget_);
+        trailTarget_ = nullptr;
+    }
+}
+
+// Redirects rendering to the trail target and fades it by one full-screen
+// blend of the background colour. The target is (re)created at window size
+// and starts cleared, so a resize restarts the trails.
+bool Application::BeginTrails() {
+    PROFILE_ZONE("Trail fade");
+    if (!trailTarget_ || trailW_ != screenWidth || trailH_ != screenHeight) {
+        if (trailTarget_) SDL_DestroyTexture(trailTarget_);
+        trailTarget_ = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32,
+                                         SDL_TEXTUREACCESS_TARGET, screenWidth, screenHeight);
+        trailW_ = screenWidth;
+        trailH_ = screenHeight;
+        if (!trailTarget_ || !SDL_SetRenderTarget(renderer, trailTarget_)) {
+            std::cerr << "[Application] Trails unavailable: " << SDL_GetError() << std::endl;
+            SetTrails(false);
+            return false;
+        }
+        SDL_SetTextureBlendMode(trailTarget_, SDL_BLENDMODE_NONE);
+        SDL_SetRenderDrawColor(renderer, 20, 20, 30, 255);
+        SDL_RenderClear(renderer);
+        return true;
+    }
+
+    SDL_SetRenderTarget(renderer, trailTarget_);
+    SDL_BlendMode mode = SDL_BLENDMODE_NONE;
+    SDL_GetRenderDrawBlendMode(renderer, &mode);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 20, 20, 30, (Uint8)std::max(1.f, trailFade_ * 255.f));
+    SDL_RenderFillRect(renderer, nullptr);
+    SDL_SetRenderDrawBlendMode(renderer, mode);
+    return true;
+}
+
+// Back to the window: the target replaces the whole frame, so the capture
+// and the GUI see it like a normally rendered one
+void Application::EndTrails() {
+    SDL_SetRenderTarget(renderer, nullptr);
+    SDL_RenderTexture(renderer, trailTarget_, nullptr, nullptr);
+}
+
+void Application::TrailControls(TrailHistory* history) {
+    bool trails = trails_;
+    if (GUI::Checkbox("Trails (F7)", &trails))
+        SetTrails(trails);
+    if (trails_) {
+        float fade = trailFade_;
+        if (GUI::SliderFloat("Trail Fade", &fade, 0.01f, 0.5f))
+            SetTrailFade(fade);
+    }
+
+    if (!history) return;
+    int tracks = history->getTracks();
+    if (GUI::SliderInt("Trail Tracks", &tracks, 0, 2000))
+        history->setTracks(tracks);
+    if (tracks > 0) {
+        int length = history->getLength();
+        if (GUI::SliderInt("Trail Length", &length, 2, 512))
+            history->setLength(length);
+    }
+}
+
 void Application::UpdateScreenSize() {
     SDL_GetWindowSize(window, &screenWidth, &screenHeight);
 }
@@ -130,6 +343,7 @@ void Application::Shutdown() {
     
     GUI::Shutdown();
     
+    trailTarget_ = nullptr;   // freed with the renderer
     if (renderer) SDL_DestroyRenderer(renderer);
     if (window) SDL_DestroyWindow(window);
     SDL_Quit();
@@ -6,6 +6,8 @@ Uint32 Input::mouseState = 0;
 Eigen::Vector2i Input::mousePosition(0, 0);
 Eigen::Vector2i Input::mouseDelta(0, 0);
 Eigen::Vector2i Input::lastMousePosition(0, 0);
+float Input::mouseWheel = 0.0f;
+float Input::mouseWheelAccum = 0.0f;
 
 void Input::Initialize() {
     int numKeys;
@@ -26,6 +28,9 @@ void Input::ProcessEvent(SDL_Event* event) {
         );
         mouseDelta = mousePosition - lastMousePosition;
     }
+    else if (event->type == SDL_EVENT_MOUSE_WHEEL) {
+        mouseWheelAccum += event->wheel.y;
+    }
 }
 
 void Input::Update() {
@@ -33,6 +38,10 @@ void Input::Update() {
     keyboardState = reinterpret_cast<const Uint8*>(SDL_GetKeyboardState(&numKeys));
     float mx, my;
     mouseState = SDL_GetMouseState(&mx, &my);
+
+    // Wheel events since the previous Update() become this frame's value
+    mouseWheel = mouseWheelAccum;
+    mouseWheelAccum = 0.0f;
 }
 
 bool Input::GetKey(SDL_Scancode key) {
@@ -0,0 +1,456 @@
+#include "Core/Profiler.h"
+#include "Core/FrameArena.h"
+
+#include <imgui.h>
+#include <implot.h>
+
+#include <chrono>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <algorithm>
+#include <filesystem>
+#include <ctime>
+#include <cstdio>
+
+namespace {
+
+using Event = Profiler::Event;
+
+const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+// ── Per-thread ring buffers ───────────────────────────────────────────────
+// Single producer (the owning thread) / single consumer (EndFrame).
+struct ThreadBuffer {
+    static constexpr uint64_t Capacity = 1u << 14;   // power of two
+
+    std::vector<Event>    ring = std::vector<Event>(Capacity);
+    std::atomic<uint64_t> head{ 0 };      // next write, owner thread
+    std::atomic<uint64_t> tail{ 0 };      // next read, drainer
+    std::atomic<uint64_t> dropped{ 0 };
+    std::atomic<bool>     retired{ false };
+
+    uint32_t    id    = 0;
+    uint32_t    depth = 0;                // owner thread only
+    std::string name;                     // guarded by registryMutex
+};
+
+std::mutex                                 registryMutex;
+std::vector<std::shared_ptr<ThreadBuffer>> registry;
+uint32_t                                   nextThreadId = 0;
+
+// Flags the buffer when its thread exits; EndFrame frees it once drained.
+struct ThreadSlot {
+    std::shared_ptr<ThreadBuffer> buffer;
+    ~ThreadSlot() {
+        if (buffer) buffer->retired.store(true, std::memory_order_release);
+    }
+};
+thread_local ThreadSlot  tlSlot;
+thread_local const char* tlPendingName = nullptr;   // SetThreadName before first zone
+
+ThreadBuffer& localBuffer() {
+    if (!tlSlot.buffer) {
+        auto b = std::make_shared<ThreadBuffer>();
+        std::lock_guard<std::mutex> lock(registryMutex);
+        b->id   = nextThreadId++;
+        b->name = tlPendingName ? tlPendingName : "thread " + std::to_string(b->id);
+        registry.push_back(b);
+        tlSlot.buffer = std::move(b);
+    }
+    return *tlSlot.buffer;
+}
+
+// ── Frame history (main thread only) ──────────────────────────────────────
+constexpr int HistoryLength = 240;
+
+struct ZoneHistory {
+    std::string        name;
+    std::vector<float> ms = std::vector<float>(HistoryLength, 0.f);
+    bool               stackable = false;   // outermost zone on the main thread
+};
+
+std::vector<ZoneHistory>             zones;
+std::unordered_map<std::string, int> zoneIndex;
+std::vector<float>                   frameMs(HistoryLength, 0.f);
+int                                  historyPos   = 0;   // next slot
+int                                  historyCount = 0;
+
+std::vector<Event>                              drained;
+std::vector<Event>                              timelineEvents;
+std::vector<std::pair<uint32_t, std::string>>   threadNames;
+uint64_t frameStartNs    = 0;
+uint64_t timelineStartNs = 0;
+uint64_t timelineEndNs   = 1;
+uint64_t droppedTotal    = 0;
+uint32_t mainThreadId    = 0;
+bool     freezeTimeline  = false;
+
+std::vector<float> frameTotals;
+
+// ── Trace capture (main thread only) ──────────────────────────────────────
+constexpr size_t MaxTraceEvents = 4000000;   // ~128 MB of events
+
+bool                                          tracing            = false;
+bool                                          enabledBeforeTrace = false;
+std::vector<Event>                            traceEvents;
+std::vector<std::pair<uint32_t, std::string>> traceThreads;
+uint64_t                                      traceDropped       = 0;
+
+void appendTrace(const std::vector<Event>& events) {
+    for (const Event& e : events) {
+        if (traceEvents.size() >= MaxTraceEvents) { ++traceDropped; continue; }
+        traceEvents.push_back(e);
+    }
+    for (const auto& tn : threadNames) {
+        auto it = std::find_if(traceThreads.begin(), traceThreads.end(),
+                               [&](const auto& t) { return t.first == tn.first; });
+        if (it == traceThreads.end()) traceThreads.push_back(tn);
+        else                          it->second = tn.second;
+    }
+}
+
+void writeJsonString(std::FILE* f, const char* s) {
+    std::fputc('"', f);
+    for (; *s; ++s) {
+        if (*s == '"' || *s == '\\') std::fputc('\\', f);
+        std::fputc(*s, f);
+    }
+    std::fputc('"', f);
+}
+
+int zoneFor(const char* name) {
+    auto it = zoneIndex.find(name);
+    if (it != zoneIndex.end()) return it->second;
+    const int idx = (int)zones.size();
+    zones.push_back({ name });
+    zoneIndex.emplace(name, idx);
+    return idx;
+}
+
+ImU32 colorFor(const char* name) {
+    static const ImU32 palette[] = {
+        IM_COL32( 86, 156, 214, 255), IM_COL32(214, 157,  86, 255),
+        IM_COL32(106, 190, 106, 255), IM_COL32(214,  96,  96, 255),
+        IM_COL32(170, 120, 214, 255), IM_COL32( 86, 200, 200, 255),
+        IM_COL32(214, 200,  86, 255), IM_COL32(200, 120, 170, 255),
+    };
+    uint32_t h = 2166136261u;
+    for (const char* p = name; *p; ++p) h = (h ^ (uint8_t)*p) * 16777619u;
+    return palette[h % (sizeof(palette) / sizeof(palette[0]))];
+}
+
+// Value at fraction p of a sorted copy of the zone's filled history
+float percentile(std::vector<float>& sorted, float p) {
+    if (sorted.empty()) return 0.f;
+    const size_t k = std::min(sorted.size() - 1, (size_t)(p * (sorted.size() - 1) + 0.5f));
+    return sorted[k];
+}
+
+void drawTimeline() {
+    ImDrawList*  dl     = ImGui::GetWindowDrawList();
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    const float  width  = std::max(ImGui::GetContentRegionAvail().x, 200.f);
+    const float  labelW = 90.f;
+    const float  lane   = 16.f;
+    const double span   = (double)std::max<uint64_t>(timelineEndNs - timelineStartNs, 1);
+    const float  plotW  = width - labelW;
+
+    // Rows: one per thread, main first, height from the deepest nesting
+    std::vector<std::pair<uint32_t, uint32_t>> rows;   // (threadId, maxDepth)
+    for (const Event& e : timelineEvents) {
+        auto it = std::find_if(rows.begin(), rows.end(),
+                               [&](const auto& r) { return r.first == e.threadId; });
+        if (it == rows.end()) rows.push_back({ e.threadId, e.depth });
+        else                  it->second = std::max(it->second, e.depth);
+    }
+    std::sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) {
+        if ((a.first == mainThreadId) != (b.first == mainThreadId))
+            return a.first == mainThreadId;
+        return a.first < b.first;
+    });
+
+    const ImVec2 mouse = ImGui::GetMousePos();
+    float y = origin.y;
+    for (const auto& [tid, maxDepth] : rows) {
+        const float rowH = (maxDepth + 1) * lane;
+
+        const char* label = "?";
+        for (const auto& tn : threadNames)
+            if (tn.first == tid) { label = tn.second.c_str(); break; }
+        dl->AddText(ImVec2(origin.x, y), IM_COL32(200, 200, 200, 255), label);
+
+        for (const Event& e : timelineEvents) {
+            if (e.threadId != tid) continue;
+            const double s0 = std::max(0.0, (double)((int64_t)(e.startNs - timelineStartNs)) / span);
+            const double s1 = std::min(1.0, (double)((int64_t)(e.endNs   - timelineStartNs)) / span);
+            if (s1 <= 0.0 || s0 >= 1.0) continue;
+
+            const ImVec2 a(origin.x + labelW + (float)s0 * plotW, y + e.depth * lane);
+            const ImVec2 b(std::max(a.x + 1.f, origin.x + labelW + (float)s1 * plotW),
+                           a.y + lane - 1.f);
+            dl->AddRectFilled(a, b, colorFor(e.name));
+            if (b.x - a.x > 30.f) {
+                dl->PushClipRect(a, b, true);
+                dl->AddText(ImVec2(a.x + 2.f, a.y), IM_COL32(0, 0, 0, 255), e.name);
+                dl->PopClipRect();
+            }
+            if (mouse.x >= a.x && mouse.x < b.x && mouse.y >= a.y && mouse.y < b.y)
+                ImGui::SetTooltip("%s\n%.3f ms", e.name, (e.endNs - e.startNs) * 1e-6);
+        }
+        y += rowH + 4.f;
+    }
+
+    ImGui::Dummy(ImVec2(width, std::max(y - origin.y, lane)));
+}
+
+} // namespace
+
+// ── Recording ─────────────────────────────────────────────────────────────
+void Profiler::SetEnabled(bool enabled) {
+    enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+uint64_t Profiler::NowNs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - epoch).count();
+}
+
+void Profiler::SetThreadName(const char* name) {
+    // No buffer is allocated until the thread records its first zone
+    if (!tlSlot.buffer) { tlPendingName = name; return; }
+    std::lock_guard<std::mutex> lock(registryMutex);
+    tlSlot.buffer->name = name;
+}
+
+uint32_t Profiler::BeginZone() {
+    return localBuffer().depth++;
+}
+
+void Profiler::EndZone(const char* name, uint64_t startNs) {
+    const uint64_t endNs = NowNs();
+    ThreadBuffer& b = localBuffer();
+    --b.depth;
+
+    const uint64_t h = b.head.load(std::memory_order_relaxed);
+    if (h - b.tail.load(std::memory_order_acquire) >= ThreadBuffer::Capacity) {
+        b.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    b.ring[h & (ThreadBuffer::Capacity - 1)] = { name, startNs, endNs, b.id, b.depth };
+    b.head.store(h + 1, std::memory_order_release);
+}
+
+// ── Per-frame drain ───────────────────────────────────────────────────────
+void Profiler::EndFrame() {
+    const uint64_t now = NowNs();
+    if (!IsEnabled()) {
+        frameStartNs = now;
+        return;
+    }
+    mainThreadId = localBuffer().id;
+
+    drained.clear();
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        threadNames.clear();
+        for (size_t i = 0; i < registry.size();) {
+            ThreadBuffer& b = *registry[i];
+            const bool     retired = b.retired.load(std::memory_order_acquire);
+            const uint64_t h = b.head.load(std::memory_order_acquire);
+            for (uint64_t t = b.tail.load(std::memory_order_relaxed); t < h; ++t)
+                drained.push_back(b.ring[t & (ThreadBuffer::Capacity - 1)]);
+            b.tail.store(h, std::memory_order_release);
+            droppedTotal += b.dropped.exchange(0, std::memory_order_relaxed);
+            threadNames.push_back({ b.id, b.name });
+
+            if (retired) registry.erase(registry.begin() + i);
+            else         ++i;
+        }
+    }
+
+    // Per-zone totals for this frame (all threads)
+    frameTotals.assign(zones.size(), 0.f);
+    for (const Event& e : drained) {
+        const int z = zoneFor(e.name);
+        if (z >= (int)frameTotals.size()) frameTotals.resize(z + 1, 0.f);
+        frameTotals[z] += (e.endNs - e.startNs) * 1e-6f;
+        if (e.threadId == mainThreadId && e.depth == 0) zones[z].stackable = true;
+    }
+    for (size_t z = 0; z < zones.size(); ++z)
+        zones[z].ms[historyPos] = frameTotals[z];
+    frameMs[historyPos] = (now - frameStartNs) * 1e-6f;
+    historyPos   = (historyPos + 1) % HistoryLength;
+    historyCount = std::min(historyCount + 1, HistoryLength);
+
+    if (tracing) {
+        // Frame marker on the main thread's track
+        drained.push_back({ "Frame", frameStartNs, now, mainThreadId, 0 });
+        appendTrace(drained);
+        drained.pop_back();
+    }
+
+    if (!freezeTimeline) {
+        timelineEvents.swap(drained);
+        timelineStartNs = frameStartNs;
+        timelineEndNs   = now;
+    }
+    frameStartNs = now;
+}
+
+// ── Trace capture ─────────────────────────────────────────────────────────
+void Profiler::StartTrace() {
+    if (tracing) return;
+    enabledBeforeTrace = IsEnabled();
+    SetEnabled(true);
+    traceEvents.clear();
+    traceThreads.clear();
+    traceDropped = 0;
+    tracing = true;
+}
+
+bool Profiler::IsTracing() { return tracing; }
+
+std::string Profiler::StopTrace() {
+    if (!tracing) return {};
+    tracing = false;
+    SetEnabled(enabledBeforeTrace);
+
+    std::error_code ec;
+    std::filesystem::create_directories("capture/", ec);
+    std::time_t now = std::time(nullptr);
+    char timeBuf[32];
+    std::strftime(timeBuf, sizeof(timeBuf), "%Y-%m-%d_%H-%M-%S", std::localtime(&now));
+    const std::string path = "capture/trace_" + std::string(timeBuf) + ".json";
+
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return {};
+
+    // Chrome Trace Event format: complete ("X") events, microsecond timestamps
+    std::fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    std::fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,"
+                    "\"args\":{\"name\":\"ArtificialLife\"}}");
+    for (const auto& [tid, name] : traceThreads) {
+        std::fprintf(f, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+                        "\"args\":{\"name\":", tid);
+        writeJsonString(f, name.c_str());
+        std::fprintf(f, "}}");
+        // Main thread first in the viewer
+        std::fprintf(f, ",\n{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+                        "\"args\":{\"sort_index\":%d}}", tid, tid == mainThreadId ? -1 : (int)tid);
+    }
+    for (const Event& e : traceEvents) {
+        std::fprintf(f, ",\n{\"name\":");
+        writeJsonString(f, e.name);
+        std::fprintf(f, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                     e.threadId, e.startNs * 1e-3, (e.endNs - e.startNs) * 1e-3);
+    }
+    std::fprintf(f, "\n]}\n");
+    const bool ok = std::fclose(f) == 0;
+
+    if (traceDropped > 0)
+        std::printf("[Profiler] Trace hit the %zu event cap, %llu events dropped\n",
+                    MaxTraceEvents, (unsigned long long)traceDropped);
+    traceEvents.clear();
+    traceEvents.shrink_to_fit();
+    return ok ? path : std::string();
+}
+
+// ── Panel ─────────────────────────────────────────────────────────────────
+void Profiler::DrawPanel(bool* open) {
+    ImGui::SetNextWindowSize(ImVec2(640, 560), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Profiler", open)) {
+        ImGui::End();
+        return;
+    }
+
+    bool enabled = IsEnabled();
+    if (ImGui::Checkbox("Enabled", &enabled)) SetEnabled(enabled);
+    ImGui::SameLine();
+    ImGui::Checkbox("Freeze timeline", &freezeTimeline);
+#if !ALIFE_PROFILER
+    ImGui::TextDisabled("Built with ENABLE_PROFILER=OFF: every zone is compiled out, so nothing is recorded.");
+    ImGui::TextDisabled("Per-stage frame timings are still printed by --timing-summary.");
+#endif
+    if (tracing)
+        ImGui::TextColored(ImVec4(1.f, 0.2f, 0.2f, 1.f), "* TRACE  %zu events  (F10 to stop)",
+                           traceEvents.size());
+    else
+        ImGui::TextDisabled("F10 : capture a Chrome/Perfetto trace");
+    if (droppedTotal > 0)
+        ImGui::TextColored(ImVec4(1.f, 0.6f, 0.f, 1.f),
+                           "%llu events dropped (ring buffer full)",
+                           (unsigned long long)droppedTotal);
+
+    const FrameArena::Stats arena = FrameArena::GetStats();
+    ImGui::Text("Frame arena: %.1f KB used, %.1f KB high-water, %.1f KB reserved (%d threads)",
+                arena.used / 1024.0, arena.highWater / 1024.0, arena.capacity / 1024.0, arena.arenas);
+
+    // Chronological copy of the history, oldest first
+    const int n = historyCount;
+    const int first = (historyPos - n + HistoryLength) % HistoryLength;
+    auto chrono = [&](const std::vector<float>& ring, std::vector<float>& out) {
+        out.resize(n);
+        for (int i = 0; i < n; ++i) out[i] = ring[(first + i) % HistoryLength];
+    };
+
+    // ===== STACKED PER-FRAME TIMINGS =====
+    if (n > 0 && ImPlot::BeginPlot("##stacked", ImVec2(-1, 200), ImPlotFlags_NoMouseText)) {
+        ImPlot::SetupAxes("frame", "ms", ImPlotAxisFlags_None, ImPlotAxisFlags_AutoFit);
+        ImPlot::SetupAxisLimits(ImAxis_X1, 0, HistoryLength - 1, ImGuiCond_Always);
+
+        std::vector<float> xs(n), lower(n, 0.f), upper(n), values;
+        for (int i = 0; i < n; ++i) xs[i] = (float)i;
+        for (const ZoneHistory& z : zones) {
+            if (!z.stackable) continue;
+            chrono(z.ms, values);
+            for (int i = 0; i < n; ++i) upper[i] = lower[i] + values[i];
+            ImPlot::PlotShaded(z.name.c_str(), xs.data(), lower.data(), upper.data(), n);
+            lower.swap(upper);
+        }
+        chrono(frameMs, values);
+        ImPlot::PlotLine("frame", xs.data(), values.data(), n);
+        ImPlot::EndPlot();
+    }
+
+    // ===== PERCENTILES =====
+    if (ImGui::CollapsingHeader("Zones", ImGuiTreeNodeFlags_DefaultOpen) &&
+        ImGui::BeginTable("##zones", 6, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
+                                         ImGuiTableFlags_SizingFixedFit))
+    {
+        ImGui::TableSetupColumn("Zone (ms/frame)", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("avg");
+        ImGui::TableSetupColumn("p50");
+        ImGui::TableSetupColumn("p95");
+        ImGui::TableSetupColumn("p99");
+        ImGui::TableSetupColumn("max");
+        ImGui::TableHeadersRow();
+
+        std::vector<float> sorted;
+        for (const ZoneHistory& z : zones) {
+            chrono(z.ms, sorted);
+            double sum = 0.0;
+            for (float v : sorted) sum += v;
+            std::sort(sorted.begin(), sorted.end());
+
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0); ImGui::TextUnformatted(z.name.c_str());
+            ImGui::TableSetColumnIndex(1); ImGui::Text("%.3f", n > 0 ? sum / n : 0.0);
+            ImGui::TableSetColumnIndex(2); ImGui::Text("%.3f", percentile(sorted, 0.50f));
+            ImGui::TableSetColumnIndex(3); ImGui::Text("%.3f", percentile(sorted, 0.95f));
+            ImGui::TableSetColumnIndex(4); ImGui::Text("%.3f", percentile(sorted, 0.99f));
+            ImGui::TableSetColumnIndex(5); ImGui::Text("%.3f", sorted.empty() ? 0.f : sorted.back());
+        }
+        ImGui::EndTable();
+    }
+
+    // ===== TIMELINE =====
+    if (ImGui::CollapsingHeader("Timeline (last frame)", ImGuiTreeNodeFlags_DefaultOpen)) {
+        ImGui::Text("%.3f ms", (timelineEndNs - timelineStartNs) * 1e-6);
+        drawTimeline();
+    }
+
+    ImGui::End();
+}
@@ -2,6 +2,8 @@
 #include "stb/stb_image_write.h"
 
 #include "Core/Recorder.h"
+#include "Core/Profiler.h"
+#include "Core/AllocTracker.h"
 #include <filesystem>
 #include <ctime>
 #include <iostream>
@@ -88,9 +90,12 @@ void Recorder::runFfmpeg() {
 }
 
 void Recorder::writerLoop() {
+    Profiler::SetThreadName("recorder writer");
+
     while (true) {
         RawFrame frame;
         {
+            PROFILE_ZONE("Writer wait");
             std::unique_lock<std::mutex> lock(queueMutex_);
             queueCV_.wait(lock, [this] {
                 return !frameQueue_.empty() || writerDone_;
@@ -105,6 +110,7 @@ void Recorder::writerLoop() {
         char filename[512];
         std::snprintf(filename, sizeof(filename), "%sframe_%05d.png", sessionDir_.c_str(), frame.index);
 
+        PROFILE_ZONE("PNG write");
         stbi_write_png(filename, frame.width, frame.height, 3, frame.pixels.data(), frame.width * 3);
     }
 }
@@ -147,6 +153,7 @@ void Recorder::toggle(int screenW, int screenH) {
 
 void Recorder::captureFrame(SDL_Renderer* renderer) {
     if (!recording_) return;
+    ALLOC_SCOPE("Recorder");
 
     if (captureCounter_++ % 2 != 0) return;
 
@@ -177,6 +184,7 @@ void Recorder::captureFrame(SDL_Renderer* renderer) {
     SDL_DestroySurface(rgb);
 
     {
+        PROFILE_ZONE("queueMutex_ lock");
         std::lock_guard<std::mutex> lock(queueMutex_);
         frameQueue_.push(std::move(frame));
     }
@@ -203,6 +211,8 @@ void Recorder::screenshot(SDL_Renderer* renderer) {
     SDL_DestroySurface(rgb);
 
     std::thread([path, pixels = std::move(pixels), w, h]() {
+        Profiler::SetThreadName("screenshot");
+        PROFILE_ZONE("Screenshot PNG");
         stbi_write_png(path.c_str(), w, h, 3, pixels.data(), w * 3);
         std::cout << "[Recorder] Screenshot -> " << path << std::endl;
     }).detach();
@@ -6,7 +6,7 @@ Uint64 Time::lastTime = 0;
 float Time::deltaTime = 0.0f;
 float Time::timeScale = 1.0f;
 float Time::unscaledDeltaTime = 0.0f;
-float Time::fixedDeltaTime = 0.02f; // 50 FPS physics
+float Time::fixedDeltaTime = 1.0f / 60.0f; // 60 Hz simulation; 0 = one step per frame
 float Time::elapsedTime = 0.0f;
 int Time::frameCount = 0;
 
@@ -0,0 +1,130 @@
+#include "Core/HeadlessRunner.h"
+#include "Core/StageTimer.h"
+#include "Core/AllocTracker.h"
+#include "Core/FrameArena.h"
+#include "Core/Debug.h"
+#include "Core/Random.h"
+#include "ParticleLife/ParticleLifeSystem.h"
+#include "Boids/BoidRenderer.h"
+#include "ParticleKNN/ParticleKNNSystem.h"
+
+#include <chrono>
+#include <vector>
+#include <cstdio>
+
+namespace {
+
+// Steps `step` warmup + frames times and prints the report.
+template<typename StepFn, typename TimingsFn>
+void runLoop(const HeadlessConfig& cfg, const char* name, long long particles,
+             StepFn step, TimingsFn timings)
+{
+    for (int i = 0; i < cfg.warmup; ++i) {
+        FrameArena::ResetAll();
+        step();
+    }
+
+    StageTotals acc;
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < cfg.frames; ++i) {
+        FrameArena::ResetAll();
+        step();
+        acc.add(timings());
+        AllocTracker::EndFrame();
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+
+    const double seconds  = std::chrono::duration<double>(t1 - t0).count();
+    const double steps    = seconds > 0.0 ? cfg.frames / seconds : 0.0;
+    const double updates  = steps * (double)particles;
+
+    std::printf("simulation        : %s\n",  name);
+    std::printf("particles         : %lld\n", particles);
+    std::printf("frames            : %d (+%d warmup)\n", cfg.frames, cfg.warmup);
+    if (Random::IsSeeded())
+        std::printf("seed              : %u\n", Random::GetSeed());
+    std::printf("wall time         : %.3f s\n", seconds);
+    std::printf("steps/s           : %.2f\n", steps);
+    std::printf("particle-updates/s: %.4g\n", updates);
+    std::printf("stages (avg ms/step):\n");
+    for (size_t k = 0; k < acc.names.size(); ++k)
+        std::printf("  %-16s %9.4f\n", acc.names[k].c_str(), acc.averageMs(k));
+    const FrameArena::Stats arena = FrameArena::GetStats();
+    std::printf("frame arena       : high-water %.1f KB, capacity %.1f KB\n",
+                arena.highWater / 1024.0, arena.capacity / 1024.0);
+    AllocTracker::PrintSummary();
+}
+
+// ── Particle Life ─────────────────────────────────────────────────────────
+int runParticleLife(const HeadlessConfig& cfg) {
+    ParticleLife::ParticleLifeSystem system;
+    system.setScreenSize(cfg.worldWidth, cfg.worldHeight);
+    system.setWorldSize(cfg.worldWidth, cfg.worldHeight);
+
+    if (!cfg.presetPath.empty()) {
+        if (!system.loadFromFile(cfg.presetPath)) {
+            Debug::LogError("Failed to load preset: ", cfg.presetPath);
+            return 1;
+        }
+    } else {
+        system.setupDefault4Clusters();
+    }
+    if (cfg.count > 0)
+        for (int c = 0; c < system.getClusterCount(); ++c)
+            system.resizeCluster(c, cfg.count);
+
+    runLoop(cfg, "particlelife", system.getTotalParticles(),
+            [&] { system.update(); },
+            [&]() -> const StageTimings& { return system.getStageTimings(); });
+    return 0;
+}
+
+// ── Boids ─────────────────────────────────────────────────────────────────
+int runBoids(const HeadlessConfig& cfg) {
+    BoidSystem system;
+    int count = 2000;
+    const int w = cfg.worldWidth, h = cfg.worldHeight;
+
+    if (!cfg.presetPath.empty() && !system.loadFromFile(cfg.presetPath, count)) {
+        Debug::LogError("Failed to load preset: ", cfg.presetPath);
+        return 1;
+    }
+    if (cfg.count > 0) count = cfg.count;
+    system.generate(count, w, h);
+
+    runLoop(cfg, "boids", system.getCount(),
+            [&] { system.update(cfg.deltaTime, w, h); },
+            [&]() -> const StageTimings& { return system.getStageTimings(); });
+    return 0;
+}
+
+// ── Particles KNN ─────────────────────────────────────────────────────────
+int runKNN(const HeadlessConfig& cfg) {
+    ParticleKNNSystem system;
+    int count = 2000;
+    const int w = cfg.worldWidth, h = cfg.worldHeight;
+
+    if (!cfg.presetPath.empty() && !system.loadFromFile(cfg.presetPath, count)) {
+        Debug::LogError("Failed to load preset: ", cfg.presetPath);
+        return 1;
+    }
+    if (cfg.count > 0) count = cfg.count;
+    system.generate(count, w, h);
+
+    runLoop(cfg, "knn", system.getCount(),
+            [&] { system.update(cfg.deltaTime, w, h); },
+            [&]() -> const StageTimings& { return system.getStageTimings(); });
+    return 0;
+}
+
+} // namespace
+
+int RunHeadless(const HeadlessConfig& config) {
+    if (config.simulation == "particlelife") return runParticleLife(config);
+    if (config.simulation == "boids")        return runBoids(config);
+    if (config.simulation == "knn")          return runKNN(config);
+
+    Debug::LogError("Unknown simulation '", config.simulation,
+                    "' (expected particlelife, boids or knn)");
+    return 1;
+}
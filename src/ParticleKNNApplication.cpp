@@ -3,7 +3,7 @@
 #include "Core/Input.h"
 #include "Core/GUI.h"
 #include "Core/Debug.h"
-#include "ParticleKNN/particleKNNSystem.h"
+#include "ParticleKNN/ParticleKNNSystem.h"
 
 // Particle application
 class ParticlesKNNApplication : public Application {
@@ -18,20 +18,25 @@ public:
     // Called once at startup
     void OnStart() override {
         Debug::Log("Particles KNN simulation starting...");
+        const ApplicationConfig& cfg = GetConfig();
+        if (!cfg.presetPath.empty() &&
+            !particleKNNSystem.loadFromFile(cfg.presetPath, particleCount))
+            Debug::LogError("Failed to load preset: ", cfg.presetPath);
+        if (cfg.particleCount > 0) particleCount = cfg.particleCount;
         particleKNNSystem.generate(particleCount, GetScreenWidth(), GetScreenHeight());
     }
     
-    // Called every frame
-    void OnUpdate(float deltaTime) override {
+    // Called at the fixed simulation rate
+    void OnFixedUpdate(float fixedDeltaTime) override {
         // Update particles if not paused
         if (!paused) {
-            particleKNNSystem.update(deltaTime, GetScreenWidth(), GetScreenHeight());
+            particleKNNSystem.update(fixedDeltaTime, GetScreenWidth(), GetScreenHeight());
         }
     }
     
-    // Called every frame for rendering
+    // Called every frame for rendering, between the last two fixed steps
     void OnRender() override {
-        particleKNNSystem.draw(GetRenderer());
+        particleKNNSystem.draw(GetRenderer(), paused ? 1.f : GetInterpolationAlpha());
     }
     
     // Called every frame for GUI
@@ -64,6 +69,10 @@ public:
             paused = !paused;
         }
         
+        GUI::Separator();
+        GUI::Text("Visualization");
+        TrailControls(&particleKNNSystem.getTrailHistory());
+        
         GUI::Separator();
         
         // KNN Parameters
@@ -0,0 +1,182 @@
+#include "Core/Application.h"
+#include "Core/Time.h"
+#include "Core/Input.h"
+#include "Core/GUI.h"
+#include "Core/Debug.h"
+#include "ParticleLife/ParticleLifeSystem3D.h"
+
+#include <cmath>
+#include <cstdio>
+
+// 3D Particle Life application
+class ParticleLife3DApplication : public Application {
+private:
+    ParticleLife::ParticleLifeSystem3D particleSystem;
+
+    bool  paused       = false;
+    bool  autoRotate   = true;
+    float rotateSpeed  = 0.1f;    // rad/s
+    int   perCluster   = 1000;
+    float worldSize    = 1500.f;
+
+    float lastMouseX_ = 0.f;
+    float lastMouseY_ = 0.f;
+
+public:
+    void OnStart() override {
+        Debug::Log("Particle Life 3D simulation starting...");
+        particleSystem.setScreenSize(GetScreenWidth(), GetScreenHeight());
+        if (GetConfig().particleCount > 0) perCluster = GetConfig().particleCount;
+        particleSystem.setupDefault4Clusters(perCluster);
+        Debug::Log("Initialized with 4 clusters x ", perCluster, " particles");
+    }
+
+    void OnFixedUpdate(float) override {
+        if (!paused)
+            particleSystem.update();
+    }
+
+    void OnUpdate(float deltaTime) override {
+        particleSystem.setScreenSize(GetScreenWidth(), GetScreenHeight());
+
+        // ── Camera: left-drag orbits, wheel dollies ───────────────────────
+        auto& cam = particleSystem.getCamera();
+        const float mx = Input::GetMouseX();
+        const float my = Input::GetMouseY();
+        if (!GUI::GetIO().WantCaptureMouse) {
+            if (Input::GetMouseButton(1))
+                cam.orbit((mx - lastMouseX_) * 0.005f, (my - lastMouseY_) * 0.005f);
+            const float wheel = Input::GetMouseWheel();
+            if (wheel != 0.f)
+                cam.dolly(std::pow(0.9f, wheel));
+        }
+        lastMouseX_ = mx;
+        lastMouseY_ = my;
+
+        if (autoRotate)
+            cam.orbit(rotateSpeed * deltaTime, 0.f);
+    }
+
+    void OnRender() override {
+        particleSystem.draw(GetRenderer());
+    }
+
+    void OnGUI() override {
+        RenderControlPanel();
+    }
+
+    void RenderControlPanel() {
+        GUI::BeginWindow("Particle Life 3D Control");
+
+        if (IsRecording()) {
+            ImGui::TextColored(ImVec4(1.f, 0.2f, 0.2f, 1.f), "* REC  (F8 to stop)");
+        } else if (IsConverting()) {
+            ImGui::TextColored(ImVec4(1.f, 0.8f, 0.f, 1.f), "Converting to MP4...");
+        } else {
+            GUI::Text("F8 : start recording");
+        }
+        GUI::SameLine();
+        if (GUI::Button("Screenshot (F9)"))
+            RequestScreenshot();
+        GUI::Separator();
+
+        // ===== SIMULATION =====
+        if (GUI::CollapsingHeader("Simulation")) {
+            if (GUI::Button(paused ? "Resume" : "Pause")) paused = !paused;
+            GUI::SameLine();
+            if (GUI::Button("Reset Positions")) particleSystem.resetPositions();
+            GUI::SameLine();
+            if (GUI::Button("Random Rules"))
+                particleSystem.generateRandomRules(-100.f, 100.f, 20.f, 200.f);
+
+            float visc = particleSystem.getViscosity();
+            if (GUI::SliderFloat("Viscosity / Friction", &visc, 0.0f, 1.0f))
+                particleSystem.setViscosity(visc);
+
+            float grav = particleSystem.getWorldGravity();
+            if (GUI::SliderFloat("World Gravity", &grav, -1.0f, 1.0f))
+                particleSystem.setWorldGravity(grav);
+
+            float ps = particleSystem.getParticleSize();
+            if (GUI::SliderFloat("Particle Size", &ps, 1.0f, 20.0f))
+                particleSystem.setParticleSize(ps);
+
+            int mode = (particleSystem.getBoundaryMode()
+                        == ParticleLife::BoundaryMode::Wrapping) ? 0 : 1;
+            if (ImGui::RadioButton("Wrapping", &mode, 0))
+                particleSystem.setBoundaryMode(ParticleLife::BoundaryMode::Wrapping);
+            GUI::SameLine();
+            if (ImGui::RadioButton("Clamping", &mode, 1))
+                particleSystem.setBoundaryMode(ParticleLife::BoundaryMode::Clamping);
+
+            GUI::Separator();
+            GUI::SliderInt("Particles / Cluster", &perCluster, 100, 50000);
+            GUI::SliderFloat("World Size", &worldSize, 200.f, 5000.f);
+            if (GUI::Button("Apply (4 clusters, random rules)")) {
+                particleSystem.setWorldSize(worldSize, worldSize, worldSize);
+                particleSystem.setupDefault4Clusters(perCluster);
+            }
+        }
+
+        // ===== CAMERA =====
+        if (GUI::CollapsingHeader("Camera")) {
+            auto& cam = particleSystem.getCamera();
+            int proj = (cam.projection == Camera3D::Projection::Perspective) ? 0 : 1;
+            if (ImGui::RadioButton("Perspective", &proj, 0))
+                cam.projection = Camera3D::Projection::Perspective;
+            GUI::SameLine();
+            if (ImGui::RadioButton("Orthographic", &proj, 1))
+                cam.projection = Camera3D::Projection::Orthographic;
+
+            GUI::Checkbox("Auto Rotate", &autoRotate);
+            GUI::SliderFloat("Rotate Speed", &rotateSpeed, -1.f, 1.f);
+
+            bool b = particleSystem.getDepthSort();
+            if (GUI::Checkbox("Depth Sort", &b)) particleSystem.setDepthSort(b);
+            b = particleSystem.getDepthFade();
+            if (GUI::Checkbox("Depth Fade", &b)) particleSystem.setDepthFade(b);
+            b = particleSystem.getShowBox();
+            if (GUI::Checkbox("Show Box", &b))   particleSystem.setShowBox(b);
+            TrailControls();
+        }
+
+        // ===== RULES =====
+        if (GUI::CollapsingHeader("Rules")) {
+            for (int ri = 0; ri < particleSystem.getRuleCount(); ++ri) {
+                auto& rule = particleSystem.getRule(ri);
+                GUI::PushID(ri);
+                char label[32];
+                sprintf(label, "C%d -> C%d", rule.clusterA, rule.clusterB);
+                GUI::Text(label);
+                GUI::SameLine();
+                GUI::SliderFloat("##g", &rule.gravity, -100.0f, 100.0f);
+                GUI::SameLine();
+                GUI::SliderFloat("##r", &rule.radius,   10.0f, 500.0f);
+                GUI::PopID();
+            }
+        }
+
+        // ===== STATISTICS =====
+        if (GUI::CollapsingHeader("Statistics")) {
+            char buf[128];
+            sprintf(buf, "Total Particles: %d", particleSystem.getTotalParticles()); GUI::Text(buf);
+            sprintf(buf, "Visible: %d",         particleSystem.getVisibleCount());   GUI::Text(buf);
+            sprintf(buf, "Rules: %d",           particleSystem.getRuleCount());      GUI::Text(buf);
+            sprintf(buf, "FPS: %.1f",           GUI::GetIO().Framerate);            GUI::Text(buf);
+        }
+
+        GUI::Separator();
+        GUI::Text("Left-drag : orbit   Wheel : zoom");
+
+        GUI::EndWindow();
+    }
+
+    void OnShutdown() override {
+        Debug::Log("Particle Life 3D simulation shutting down...");
+    }
+};
+
+// Factory function
+Application* CreateParticleLife3DApplication() {
+    return new ParticleLife3DApplication();
+}
@@ -3,11 +3,15 @@
 #include "Core/Input.h"
 #include "Core/GUI.h"
 #include "Core/Debug.h"
+#include "Core/SimulationThread.h"
 #include "ParticleLife/ParticleLifeSystem.h"
+#include "ParticleLife/Ensemble.h"
 #include "AudioCPPN/AudioCPPN.h"
 
 #include <filesystem>
 #include <algorithm>
+#include <cmath>
+#include <utility>
 
 class ParticleLifeApplication : public Application {
 private:
@@ -16,6 +20,54 @@ private:
 
     bool paused = false;
 
+    // Fast-forward: several steps per fixed tick, or as many as fit in
+    // renderIntervalMs_ when maxSpeed_ is set
+    int         stepsPerTick_     = 1;
+    bool        maxSpeed_         = false;
+    float       renderIntervalMs_ = 100.f;
+    int         lastSteps_        = 0;
+    float       stepsPerSec_      = 0.f;
+    StageTotals stepTotals_;   // simulation stages summed over the frame's steps
+
+    // Fixed-step ticks counted by OnFixedUpdate and consumed by the next step
+    // batch. Drawing blends the positions before and after the last tick by
+    // GetInterpolationAlpha() when interpolate_ is set.
+    int  pendingTicks_ = 0;
+    bool interpolate_  = true;
+
+    // Mouse brush sampled each frame and applied once per tick
+    struct Brush {
+        bool  active = false;
+        float x = 0.f, y = 0.f, strength = 0.f, radius = 0.f;
+    } brush_;
+
+    // Simulation thread: the frame's steps run on sim_ while the main thread
+    // draws view_, the snapshot published by the previous job. particleSystem
+    // belongs to the job from OnRender until the wait() in the next OnUpdate;
+    // input, AudioCPPN and GUI edits all land in between.
+    bool                             threaded_      = false;
+    bool                             snapshotReady_ = false;
+    float                            lastDelta_     = 0.f;
+    SimulationThread                 sim_;
+    ParticleLife::ParticleLifeSystem view_;
+    ParticleLife::ParticleLifeSystem published_;
+
+    // Ensemble mode: K small worlds stepped in one parallel region
+    ParticleLife::Ensemble ensemble_;
+    bool ensembleMode_       = false;
+    int  ensembleWorlds_     = 64;
+    int  ensembleClusters_   = 4;
+    int  ensemblePerCluster_ = 500;
+    int  ensembleWorldSize_  = 800;
+    int  ensembleView_       = 0;
+
+    // World / camera
+    int   worldW_          = 1920;
+    int   worldH_          = 1080;
+    int   particlesPerCluster_ = 1000;
+    float lastMouseX_      = 0.f;
+    float lastMouseY_      = 0.f;
+
     // "Add new rule" form
     int   newRuleFrom    = 0;
     int   newRuleTo      = 0;
@@ -57,36 +109,169 @@ public:
         }
         Debug::Log("Particle Life simulation starting...");
         particleSystem.setScreenSize(GetScreenWidth(), GetScreenHeight());
-        particleSystem.setupDefault4Clusters();
-        Debug::Log("Initialized with 4 clusters x 1000 particles");
+        worldW_ = GetScreenWidth();
+        worldH_ = GetScreenHeight();
+        particleSystem.setWorldSize(worldW_, worldH_);
+
+        const ApplicationConfig& cfg = GetConfig();
+        if (!cfg.presetPath.empty() && particleSystem.loadFromFile(cfg.presetPath)) {
+            worldW_ = particleSystem.getWorldWidth();
+            worldH_ = particleSystem.getWorldHeight();
+            Debug::Log("Loaded preset: ", cfg.presetPath);
+        } else {
+            if (!cfg.presetPath.empty())
+                Debug::LogError("Failed to load preset: ", cfg.presetPath);
+            particleSystem.setupDefault4Clusters();
+        }
+        if (cfg.particleCount > 0) {
+            particlesPerCluster_ = cfg.particleCount;
+            for (int c = 0; c < particleSystem.getClusterCount(); ++c)
+                particleSystem.resizeCluster(c, particlesPerCluster_);
+        }
+        Debug::Log("Initialized with ", particleSystem.getClusterCount(), " clusters, ",
+                   particleSystem.getTotalParticles(), " particles");
     }
 
     void OnUpdate(float deltaTime) override {
+        sim_.wait();
+        if (snapshotReady_) {
+            std::swap(view_, published_);
+            snapshotReady_ = false;
+        }
+        lastDelta_ = deltaTime;
         particleSystem.setScreenSize(GetScreenWidth(), GetScreenHeight());
 
+        if (ensembleMode_) {
+            stepTotals_.clear();
+            lastSteps_ = 0;
+            const int ticks = std::exchange(pendingTicks_, 0);
+            if (!paused)
+                runSteps(deltaTime, ticks, [&] { ensemble_.step(); }, [] {});
+            if (saveMessageTimer_ > 0.f)
+                saveMessageTimer_ -= deltaTime;
+            return;
+        }
+
         audioCPPN.update(&particleSystem);
 
-        if (!paused)
-            particleSystem.update();
+        // ── Camera + mouse interaction ────────────────────────────────────
+        updateCamera();
 
-        // ── Mouse interaction ─────────────────────────────────────────────
+        brush_.active = false;
         if (!GUI::GetIO().WantCaptureMouse) {
-            const float mx  = Input::GetMouseX();
-            const float my  = Input::GetMouseY();
-            const float rad = particleSystem.getMouseRadius();
+            // Brush radius is in screen pixels, forces act in world space
+            const auto& cam = particleSystem.getCamera();
             const float str = particleSystem.getMouseStrength();
-
+            brush_.x      = particleSystem.screenToWorldX(Input::GetMouseX());
+            brush_.y      = particleSystem.screenToWorldY(Input::GetMouseY());
+            brush_.radius = particleSystem.getMouseRadius() / cam.zoom;
+            brush_.strength = 0.f;
             if (Input::GetMouseButton(1))  // Left-click  → attraction
-                particleSystem.applyMouseForce(mx, my, -str, rad);
+                brush_.strength -= str;
             if (Input::GetMouseButton(3))  // Right-click → repulsion
-                particleSystem.applyMouseForce(mx, my,  str, rad);
+                brush_.strength += str;
+            brush_.active = Input::GetMouseButton(1) || Input::GetMouseButton(3);
         }
 
+        if (!threaded_)
+            stepFrame(deltaTime, std::exchange(pendingTicks_, 0));
+
         if (saveMessageTimer_ > 0.f)
             saveMessageTimer_ -= deltaTime;
     }
 
+    void OnFixedUpdate(float) override {
+        ++pendingTicks_;
+    }
+
+    void stepFrame(float deltaTime, int ticks) {
+        stepTotals_.clear();
+        lastSteps_ = 0;
+        if (!paused)
+            runSteps(deltaTime, ticks,
+                [&] {
+                    particleSystem.update();
+                    stepTotals_.add(particleSystem.getStageTimings());
+                },
+                [&] {
+                    particleSystem.storePreviousPositions();
+                    if (brush_.active)
+                        particleSystem.applyMouseForce(brush_.x, brush_.y,
+                                                       brush_.strength, brush_.radius);
+                });
+    }
+
+    // Runs stepsPerTick_ steps for each fixed tick, calling tick() before
+    // each batch. In max-speed mode tick() runs once and stepping goes on
+    // until renderIntervalMs_ has passed; only then does the frame render.
+    template <class Step, class Tick>
+    void runSteps(float deltaTime, int ticks, const Step& step, const Tick& tick) {
+        int steps = 0;
+        if (maxSpeed_) {
+            const Uint64 start = SDL_GetPerformanceCounter();
+            const Uint64 budget = (Uint64)(renderIntervalMs_ * 1e-3 * SDL_GetPerformanceFrequency());
+            tick();
+            do {
+                step();
+                ++steps;
+            } while (SDL_GetPerformanceCounter() - start < budget);
+        } else {
+            for (int t = 0; t < ticks; ++t) {
+                tick();
+                for (int k = 0; k < stepsPerTick_; ++k, ++steps)
+                    step();
+            }
+        }
+        lastSteps_   = steps;
+        stepsPerSec_ = deltaTime > 0.f ? steps / deltaTime : 0.f;
+    }
+
+    // Middle-drag pans, wheel zooms around the cursor, Home re-fits the world.
+    void updateCamera() {
+        auto& cam = particleSystem.getCamera();
+        const float mx = Input::GetMouseX();
+        const float my = Input::GetMouseY();
+
+        if (!GUI::GetIO().WantCaptureMouse) {
+            if (Input::GetMouseButton(2))
+                cam.panPixels(mx - lastMouseX_, my - lastMouseY_);
+
+            const float wheel = Input::GetMouseWheel();
+            if (wheel != 0.f)
+                cam.zoomAt(mx, my, std::pow(1.15f, wheel));
+        }
+
+        if (!GUI::GetIO().WantCaptureKeyboard && Input::GetKey(SDL_SCANCODE_HOME))
+            particleSystem.fitCamera();
+
+        lastMouseX_ = mx;
+        lastMouseY_ = my;
+    }
+
     void OnRender() override {
+        if (ensembleMode_ && ensemble_.getWorldCount() > 0) {
+            ensembleView_ = std::clamp(ensembleView_, 0, ensemble_.getWorldCount() - 1);
+            auto& world = ensemble_.getWorld(ensembleView_);
+            world.setScreenSize(GetScreenWidth(), GetScreenHeight());
+            world.fitCamera();
+            world.draw(GetRenderer());
+            return;
+        }
+        // Max speed renders whatever state the budget reached: nothing to blend
+        const float alpha = interpolate_ && !paused && !maxSpeed_ ? GetInterpolationAlpha() : 1.f;
+        if (threaded_) {
+            // Input and GUI edits are in: step the next frame while this one draws
+            view_.getCamera() = particleSystem.getCamera();
+            sim_.run([this, dt = lastDelta_, ticks = std::exchange(pendingTicks_, 0)] {
+                stepFrame(dt, ticks);
+                published_     = particleSystem;
+                snapshotReady_ = true;
+            });
+            view_.setInterpolation(alpha);
+            view_.draw(GetRenderer());
+            return;
+        }
+        particleSystem.setInterpolation(alpha);
         particleSystem.draw(GetRenderer());
     }
 
@@ -119,6 +304,26 @@ public:
             GUI::SameLine();
             if (GUI::Button("Reset Positions")) particleSystem.resetPositions();
 
+            // ── Fast-forward ───────────────────────────────────────────────
+            GUI::Checkbox("As Fast As Possible", &maxSpeed_);
+            if (maxSpeed_)
+                GUI::SliderFloat("Render Every (ms)", &renderIntervalMs_, 16.f, 1000.f);
+            else
+                GUI::SliderInt("Steps / Tick", &stepsPerTick_, 1, 64);
+            ImGui::Text("%d step(s) this frame, %.0f steps/s", lastSteps_, stepsPerSec_);
+            if (Time::FixedDeltaTime() > 0.f)
+                ImGui::TextDisabled("Fixed step %.0f Hz, %d tick(s) this frame",
+                                    1.f / Time::FixedDeltaTime(), GetFixedSteps());
+            else
+                ImGui::TextDisabled("Lockstep: one tick per frame");
+            GUI::Checkbox("Interpolate", &interpolate_);
+
+            if (GUI::Checkbox("Simulation Thread", &threaded_) && threaded_)
+                view_ = particleSystem;   // something to draw until the first job publishes
+            if (threaded_)
+                ImGui::TextDisabled("Step job %.2f ms on %d thread(s), render waited %.2f ms",
+                                    sim_.getLastJobMs(), sim_.getJobThreads(), sim_.getLastWaitMs());
+
             GUI::Separator();
 
             float visc = particleSystem.getViscosity();
@@ -135,6 +340,42 @@ public:
 
             GUI::Separator();
 
+            // ── Collision core ─────────────────────────────────────────────
+            bool collide = particleSystem.getCollisionEnabled();
+            if (GUI::Checkbox("Collision Core", &collide))
+                particleSystem.setCollisionEnabled(collide);
+
+            if (collide) {
+                float stiff = particleSystem.getCollisionStiffness();
+                if (GUI::SliderFloat("Core Stiffness", &stiff, 0.05f, 1.0f))
+                    particleSystem.setCollisionStiffness(stiff);
+                ImGui::TextDisabled("Fraction of the overlap removed per substep");
+
+                int maxSub = particleSystem.getMaxSubsteps();
+                if (GUI::SliderInt("Max Substeps", &maxSub, 1, 16))
+                    particleSystem.setMaxSubsteps(maxSub);
+            }
+
+            // ── Sleeping regions ───────────────────────────────────────────
+            bool sleeping = particleSystem.getSleepingEnabled();
+            if (GUI::Checkbox("Sleeping Regions", &sleeping))
+                particleSystem.setSleepingEnabled(sleeping);
+
+            if (sleeping) {
+                float sleepSpeed = particleSystem.getSleepSpeed();
+                if (GUI::SliderFloat("Sleep Speed", &sleepSpeed, 0.0f, 0.5f))
+                    particleSystem.setSleepSpeed(sleepSpeed);
+
+                int sleepFrames = particleSystem.getSleepFrames();
+                if (GUI::SliderInt("Sleep Frames", &sleepFrames, 1, 240))
+                    particleSystem.setSleepFrames(sleepFrames);
+
+                ImGui::Text("Active cells: %d / %d",
+                            particleSystem.getActiveCells(), particleSystem.getTotalCells());
+            }
+
+            GUI::Separator();
+
             // ── Mouse interaction ──────────────────────────────────────────
             GUI::Text("Mouse Interaction:");
 
@@ -162,6 +403,55 @@ public:
 
             GUI::Separator();
 
+            // ── World / camera ─────────────────────────────────────────────
+            GUI::Text("World (independent of window):");
+            ImGui::InputInt("World Width",  &worldW_, 100, 1000);
+            ImGui::InputInt("World Height", &worldH_, 100, 1000);
+            worldW_ = std::clamp(worldW_, 200, 100000);
+            worldH_ = std::clamp(worldH_, 200, 100000);
+            if (GUI::Button("Apply World Size"))
+                particleSystem.setWorldSize(worldW_, worldH_);
+            GUI::SameLine();
+            if (GUI::Button("Fit View (Home)"))
+                particleSystem.fitCamera();
+
+            ImGui::InputInt("Particles / Cluster", &particlesPerCluster_, 100, 10000);
+            particlesPerCluster_ = std::clamp(particlesPerCluster_, 10, 1000000);
+            if (GUI::Button("Apply To All Clusters"))
+                for (int i = 0; i < particleSystem.getClusterCount(); ++i)
+                    particleSystem.resizeCluster(i, particlesPerCluster_);
+
+            float zoom = particleSystem.getCamera().zoom;
+            if (GUI::SliderFloat("Zoom", &zoom, 0.01f, 10.0f))
+                particleSystem.getCamera().zoom = zoom;
+
+            GUI::Separator();
+
+            // ── Render mode ────────────────────────────────────────────────
+            GUI::Text("Render Mode:");
+            GUI::SameLine();
+
+            int renderMode = (int)particleSystem.getRenderMode();
+            if (ImGui::RadioButton("Sprites", &renderMode, (int)ParticleLife::RenderMode::Sprites))
+                particleSystem.setRenderMode(ParticleLife::RenderMode::Sprites);
+            GUI::SameLine();
+            if (ImGui::RadioButton("CPU Splat", &renderMode, (int)ParticleLife::RenderMode::Splat))
+                particleSystem.setRenderMode(ParticleLife::RenderMode::Splat);
+            GUI::SameLine();
+            if (ImGui::RadioButton("Density", &renderMode, (int)ParticleLife::RenderMode::Density))
+                particleSystem.setRenderMode(ParticleLife::RenderMode::Density);
+
+            if (particleSystem.getRenderMode() == ParticleLife::RenderMode::Density) {
+                int cellSize = particleSystem.getDensityCellSize();
+                if (GUI::SliderInt("Density Cell (px)", &cellSize, 1, 16))
+                    particleSystem.setDensityCellSize(cellSize);
+
+                bool heat = particleSystem.getDensityColoring() == DensityMap::Coloring::Heat;
+                if (GUI::Checkbox("Heat Colour Map", &heat))
+                    particleSystem.setDensityColoring(heat ? DensityMap::Coloring::Heat
+                                                           : DensityMap::Coloring::ClusterBlend);
+            }
+
             // ── Connections ────────────────────────────────────────────────
             bool showConn = particleSystem.getShowConnections();
             if (GUI::Checkbox("Show Connections", &showConn))
@@ -175,7 +465,19 @@ public:
                 int maxConn = particleSystem.getMaxConnections();
                 if (GUI::SliderInt("Max Connections", &maxConn, 1, 20))
                     particleSystem.setMaxConnections(maxConn);
+
+                bool physicsLinks = particleSystem.getPhysicsLinks();
+                if (GUI::Checkbox("Reuse Physics Neighbours", &physicsLinks))
+                    particleSystem.setPhysicsLinks(physicsLinks);
+                if (physicsLinks)
+                    ImGui::TextDisabled("%d / %d clusters from physics (needs a self-rule radius >= %.0f)",
+                                        (threaded_ ? view_ : particleSystem).getLinkedClusters(),
+                                        particleSystem.getClusterCount(),
+                                        particleSystem.getConnectionRadius());
             }
+
+            // ── Trails ─────────────────────────────────────────────────────
+            TrailControls(&particleSystem.getTrailHistory());
         }
 
         // ===== CLUSTERS =====
@@ -326,6 +628,8 @@ public:
             if (GUI::Button("  Load  ")) {
                 std::string path = makeFullPath();
                 if (particleSystem.loadFromFile(path)) {
+                    worldW_ = particleSystem.getWorldWidth();
+                    worldH_ = particleSystem.getWorldHeight();
                     sprintf(saveMessage_, "Loaded: %s", savePath_);
                     Debug::Log("Preset loaded: " + path);
                 } else {
@@ -364,6 +668,46 @@ public:
             if (GUI::Button("Sorting"))         setupSpontaneousSorting();
         }
 
+        // ===== ENSEMBLE =====
+        if (GUI::CollapsingHeader("Ensemble")) {
+            GUI::SliderInt("Worlds (K)",        &ensembleWorlds_,     1, 1024);
+            GUI::SliderInt("Clusters / World",  &ensembleClusters_,   1, 8);
+            GUI::SliderInt("Particles / Cluster##ens", &ensemblePerCluster_, 50, 5000);
+            GUI::SliderInt("World Size##ens",   &ensembleWorldSize_, 200, 4000);
+
+            if (GUI::Button("Build Ensemble")) {
+                ensemble_.configure(ensembleWorlds_, ensembleClusters_, ensemblePerCluster_,
+                                    ensembleWorldSize_, ensembleWorldSize_);
+                ensembleView_ = 0;
+                ensembleMode_ = true;
+            }
+            GUI::SameLine();
+            if (ensemble_.getWorldCount() > 0) {
+                GUI::Checkbox("Ensemble Mode", &ensembleMode_);
+
+                if (GUI::Button("Randomise All Rules")) ensemble_.randomiseAllRules();
+                GUI::SameLine();
+                if (GUI::Button("Reset All Positions")) ensemble_.resetAllPositions();
+
+                GUI::SliderInt("View World", &ensembleView_, 0, ensemble_.getWorldCount() - 1);
+                if (GUI::Button("Adopt Viewed World")) {
+                    // Copy the viewed world (rules + state) into the editable system
+                    particleSystem = ensemble_.getWorld(ensembleView_);
+                    particleSystem.setScreenSize(GetScreenWidth(), GetScreenHeight());
+                    particleSystem.fitCamera();
+                    worldW_ = particleSystem.getWorldWidth();
+                    worldH_ = particleSystem.getWorldHeight();
+                    ensembleMode_ = false;
+                }
+
+                ImGui::Text("Step: %.2f ms   %.1f M particle-updates/s",
+                            ensemble_.getLastStepMs(),
+                            ensemble_.getParticleUpdatesPerSec() * 1e-6);
+                ImGui::Text("%d worlds, %d particles total",
+                            ensemble_.getWorldCount(), ensemble_.getTotalParticles());
+            }
+        }
+
         // ===== STATISTICS =====
         if (GUI::CollapsingHeader("Statistics")) {
             char buf[256];
@@ -376,6 +720,32 @@ public:
                 (particleSystem.getBoundaryMode() == ParticleLife::BoundaryMode::Wrapping)
                 ? "Wrapping" : "Clamping";
             sprintf(buf, "Boundary: %s", modeStr); GUI::Text(buf);
+            sprintf(buf, "World: %d x %d  (zoom %.2f)",
+                    particleSystem.getWorldWidth(), particleSystem.getWorldHeight(),
+                    particleSystem.getCamera().zoom);
+            GUI::Text(buf);
+            if (particleSystem.getCollisionEnabled()) {
+                sprintf(buf, "Collision substeps: %d", particleSystem.getLastSubsteps());
+                GUI::Text(buf);
+            }
+            if (particleSystem.getSleepingEnabled()) {
+                sprintf(buf, "Active cells: %d / %d",
+                        particleSystem.getActiveCells(), particleSystem.getTotalCells());
+                GUI::Text(buf);
+            }
+
+            // ── Stage timings ──────────────────────────────────────────────
+            GUI::Separator();
+            const StageTimings& frame = GetFrameTimings();
+            ImGui::Text("Frame: %.2f ms", frame.total());
+            for (int i = 0; i < frame.count; ++i)
+                ImGui::Text("  %-10s %8.3f ms", frame.names[i], frame.ms[i]);
+            if (!stepTotals_.names.empty()) {
+                ImGui::Text("Simulation, %d step(s):", lastSteps_);
+                for (size_t k = 0; k < stepTotals_.names.size(); ++k)
+                    ImGui::Text("  %-10s %8.3f ms", stepTotals_.names[k].c_str(),
+                                stepTotals_.totalMs[k]);
+            }
         }
 
         GUI::EndWindow();
@@ -456,21 +826,43 @@ public:
         GUI::BulletText("Each rule has its own Gravity AND Radius");
         GUI::BulletText("Viscosity : global damping");
         GUI::BulletText("World Gravity : constant downward pull");
+        GUI::BulletText("Collision Core : particles can't overlap (radius = size)");
+        GUI::BulletText("Sleeping Regions : freeze cells at equilibrium until disturbed");
+        GUI::BulletText("Steps / Tick : steps per fixed tick, only the last one is drawn");
+        GUI::BulletText("Interpolate : blend the last two ticks when drawing");
+        GUI::BulletText("As Fast As Possible : step continuously, draw every N ms");
+        GUI::BulletText("Simulation Thread : step the next frame while this one draws");
         GUI::Separator();
         GUI::Text("Mouse Interaction:");
         GUI::BulletText("Left-click  : attract particles toward cursor");
         GUI::BulletText("Right-click : repel  particles away from cursor");
         GUI::BulletText("Adjust Mouse Radius & Strength in Simulation panel");
         GUI::Separator();
+        GUI::Text("Camera:");
+        GUI::BulletText("Middle-drag : pan");
+        GUI::BulletText("Mouse wheel : zoom around cursor");
+        GUI::BulletText("Home        : fit the whole world in view");
+        GUI::Separator();
         GUI::Text("Connections:");
         GUI::BulletText("Connects nearby particles of the same cluster");
         GUI::BulletText("Connection Radius : max distance for a link");
         GUI::BulletText("Max Connections : max links per particle");
+        GUI::BulletText("Reuse Physics Neighbours : links found by the force pass, no extra grid query");
         GUI::Separator();
         GUI::Text("Boundary Modes:");
         GUI::BulletText("Wrapping : particles teleport to opposite side");
         GUI::BulletText("Clamping : particles stop at the edge");
         GUI::Separator();
+        GUI::Text("Render Modes:");
+        GUI::BulletText("Sprites   : one batched draw call for all particles");
+        GUI::BulletText("CPU Splat : multithreaded raster into one texture (large counts)");
+        GUI::BulletText("Density   : particles per cell as a heatmap (200k+ particles)");
+        GUI::Separator();
+        GUI::Text("Trails:");
+        GUI::BulletText("F7 / Trails : fade the previous frames instead of clearing");
+        GUI::BulletText("Trail Fade  : background blended per frame, higher = shorter");
+        GUI::BulletText("Trail Tracks : exact polylines for that many particles");
+        GUI::Separator();
         GUI::Text("Recording:");
         GUI::BulletText("F8 : start / stop recording");
         GUI::BulletText("ImGui windows are NOT recorded");
@@ -542,6 +934,7 @@ public:
     }
 
     void OnShutdown() override {
+        sim_.wait();
         Debug::Log("Particle Life simulation shutting down...");
     }
 };
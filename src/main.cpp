@@ -3,36 +3,122 @@
 #include "Core/Input.h"
 #include "Core/GUI.h"
 #include "Core/Debug.h"
+#include "Core/Random.h"
+#include "Core/HeadlessRunner.h"
 #include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 // Forward declarations
 Application* CreateBoidsApplication();
 Application* CreateParticlesKNNApplication();
 Application* CreateParticleLifeApplication();
+Application* CreateParticleLife3DApplication();
+
+static void PrintUsage(const char* exe) {
+    std::printf(
+        "Usage: %s [options]\n"
+        "  --sim <name>        particlelife (default), particlelife3d, boids, knn\n"
+        "  --preset <file>     load a preset JSON at startup\n"
+        "  --count <n>         particle count (per cluster for Particle Life)\n"
+        "  --threads <n>       OpenMP thread count\n"
+        "  --seed <n>          seed the random generator (reproducible runs)\n"
+        "  --width <px>        window width  (world width  when headless)\n"
+        "  --height <px>       window height (world height when headless)\n"
+        "  --vsync / --no-vsync\n"
+        "  --frames <n>        quit after n frames\n"
+        "  --fixed-hz <n>      simulation steps per second (default 60, 0 = one per frame)\n"
+        "  --timing-summary    print per-stage frame timings at exit\n"
+        "  --headless          no window: step --frames times and print throughput\n"
+        "  --help\n", exe);
+}
 
 // Entry point
 int main(int argc, char* argv[]) {
-    // Create application instance
-    // Application* app = CreateBoidsApplication();
-    // Application* app = CreateParticlesKNNApplication();
-    Application* app = CreateParticleLifeApplication();
-    
-    // Configure application
+    std::string sim = "particlelife";
+    bool headless = false;
+    int threads = 0;
     ApplicationConfig config;
-    // config.title = "ArtificialLife - Boids Simulation";
-    // config.title = "ArtificialLife - Particles KNN Simulation";
-    config.title = "ArtificialLife - Particles Life Simulation";
-    config.width = 1920;
-    config.height = 1080;
+    HeadlessConfig headlessConfig;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if      (arg == "--help" || arg == "-h")       { PrintUsage(argv[0]); return 0; }
+        else if (arg == "--headless")                  headless = true;
+        else if (arg == "--vsync")                     config.vsync = true;
+        else if (arg == "--no-vsync")                  config.vsync = false;
+        else if (arg == "--timing-summary")            config.timingSummary = true;
+        else if (arg == "--sim"     && hasValue)       sim = argv[++i];
+        else if (arg == "--preset"  && hasValue)       config.presetPath = argv[++i];
+        else if (arg == "--count"   && hasValue)       config.particleCount = std::atoi(argv[++i]);
+        else if (arg == "--threads" && hasValue)       threads = std::atoi(argv[++i]);
+        else if (arg == "--seed"    && hasValue)       Random::Seed((uint32_t)std::strtoul(argv[++i], nullptr, 10));
+        else if (arg == "--width"   && hasValue)       config.width = std::atoi(argv[++i]);
+        else if (arg == "--height"  && hasValue)       config.height = std::atoi(argv[++i]);
+        else if (arg == "--frames"  && hasValue)       config.maxFrames = std::atoi(argv[++i]);
+        else if (arg == "--fixed-hz" && hasValue) {
+            const float hz = (float)std::atof(argv[++i]);
+            Time::SetFixedDeltaTime(hz > 0.f ? 1.f / hz : 0.f);
+        }
+        else {
+            Debug::LogError("Unknown or incomplete argument: ", arg);
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (threads > 0) {
+#ifdef _OPENMP
+        omp_set_num_threads(threads);
+#else
+        Debug::LogWarning("--threads ignored: built without OpenMP");
+#endif
+    }
+
+    if (headless) {
+        headlessConfig.simulation  = sim;
+        headlessConfig.presetPath  = config.presetPath;
+        headlessConfig.count       = config.particleCount;
+        headlessConfig.worldWidth  = config.width;
+        headlessConfig.worldHeight = config.height;
+        if (config.maxFrames > 0) headlessConfig.frames = config.maxFrames;
+        return RunHeadless(headlessConfig);
+    }
+
+    // Create application instance
+    Application* app = nullptr;
+    if (sim == "particlelife") {
+        app = CreateParticleLifeApplication();
+        config.title = "ArtificialLife - Particles Life Simulation";
+    } else if (sim == "particlelife3d") {
+        app = CreateParticleLife3DApplication();
+        config.title = "ArtificialLife - Particles Life 3D Simulation";
+    } else if (sim == "boids") {
+        app = CreateBoidsApplication();
+        config.title = "ArtificialLife - Boids Simulation";
+    } else if (sim == "knn") {
+        app = CreateParticlesKNNApplication();
+        config.title = "ArtificialLife - Particles KNN Simulation";
+    } else {
+        Debug::LogError("Unknown simulation '", sim, "'");
+        PrintUsage(argv[0]);
+        return 1;
+    }
     config.resizable = true;
-    
+
     // Initialize and run
     if (app->Initialize(config)) {
         app->Run();
     }
-    
+
     // Cleanup
     delete app;
-    
+
     return 0;
-}
\ No newline at end of file
+}